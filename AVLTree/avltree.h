@@ -341,7 +341,9 @@ void AvlTree<T>::clear()
     if (head != nullptr)
     {
         delete head;
+        head = nullptr;
     }
+    numElements = 0;
 }
 
 
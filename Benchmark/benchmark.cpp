@@ -0,0 +1,926 @@
+#include <Benchmark/benchmark.h>
+#include <Parser/ingestpool.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <experimental/filesystem>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+/**
+ *
+ * run(int, char**)
+ *
+ * Parses the arguments, creates the corpus, and runs every benchmark. The
+ * SegmentedIndex, HashIndex, and AVLIndex are each built, queried, saved,
+ * updated, and loaded back, and the saved index is then queried through a
+ * MappedIndex.
+ *
+ * @param argc  - the number of arguments
+ * @param argv  - the arguments given to the program
+ * @return      - 0 on success, 1 for invalid arguments, 2 if a benchmark fails
+ */
+int Benchmark::run(int argc, char** argv)
+{
+    namespace fs = std::experimental::filesystem;
+
+    if(!parseArguments(argc, argv))
+    {
+        printUsage();
+        return 1;
+    }
+
+    if(!corpus.empty())
+    {
+        if(!fs::is_directory(corpus))
+        {
+            std::cerr << "The directory " << corpus << " does not exist." << std::endl;
+            return 2;
+        }
+        extractCorpus();
+    }
+    else
+    {
+        generateCorpus();
+    }
+
+    benchmarkTokenize();
+
+    indexFile = (fs::temp_directory_path() / "IndexBench.idx").string();
+
+    //Build, query, save, and load each data structure
+    for(int type{}; type < 3; type++)
+    {
+        //A SegmentedIndex would adopt an index file left by another index as a segment
+        removeIndexFiles();
+
+        IndexInterface* index = newIndex(type);
+        index->setIndexFile(indexFile);
+        benchmarkInsert(index);
+        if(queries.empty())
+            generateQueries(index);
+        benchmarkQueries(index);
+        benchmarkCachedQueries(index);
+        benchmarkSave(index);
+        benchmarkUpdate(index);
+        delete index;
+
+        IndexInterface* loaded = newIndex(type);
+        benchmarkLoad(loaded);
+        delete loaded;
+    }
+
+    //Search the saved index in place
+    IndexInterface* mapped = new MappedIndex();
+    benchmarkLoad(mapped);
+    benchmarkQueries(mapped);
+    delete mapped;
+
+    benchmarkConcurrentQueries();
+    benchmarkServer();
+
+    removeIndexFiles();
+    printResults();
+    return 0;
+}
+
+/**
+ *
+ * parseArguments(int, char**)
+ *
+ * Reads the options from the program arguments. Every option takes a value.
+ *
+ * @param argc  - the number of arguments
+ * @param argv  - the arguments given to the program
+ * @return      - true if the arguments are valid, false if not
+ */
+bool Benchmark::parseArguments(int argc, char** argv)
+{
+    for(int i{1}; i < argc; i++)
+    {
+        std::string arg{argv[i]};
+        if(i + 1 >= argc)
+            return false;
+
+        std::string value{argv[++i]};
+        if(arg == "--corpus")
+            corpus = value;
+        else if(arg == "--docs")
+            numDocs = std::atoi(value.c_str());
+        else if(arg == "--words")
+            wordsPerDoc = std::atoi(value.c_str());
+        else if(arg == "--vocabulary")
+            vocabularySize = std::atoi(value.c_str());
+        else if(arg == "--queries")
+            numQueries = std::atoi(value.c_str());
+        else if(arg == "--seed")
+            seed = std::atoi(value.c_str());
+        else if(arg == "--threads")
+            Parser::setNumThreads(std::atoi(value.c_str()));
+        else if(arg == "--format")
+            format = value;
+        else
+            return false;
+    }
+
+    return numDocs > 0 && wordsPerDoc > 0 && vocabularySize > 0 && numQueries > 0
+            && (format == "tsv" || format == "json");
+}
+
+/**
+ *
+ * generateCorpus()
+ *
+ * Generates a synthetic corpus of random words. The words are drawn from
+ * a fixed vocabulary with a Zipf distribution, like the words of natural
+ * text, and every document is tokenized so it can be inserted.
+ */
+void Benchmark::generateCorpus()
+{
+    std::mt19937 random{seed};
+
+    //Vocabulary of random lowercase words
+    std::vector<std::string> vocabulary;
+    std::uniform_int_distribution<int> length{3, 12};
+    std::uniform_int_distribution<int> letter{'a', 'z'};
+    for(int i{}; i < vocabularySize; i++)
+    {
+        std::string word;
+        for(int j = length(random); j > 0; j--)
+            word += (char) letter(random);
+        vocabulary.push_back(word);
+    }
+
+    //Cumulative Zipf distribution, where word i has weight 1 / (i + 1)
+    std::vector<double> cumulative;
+    double total{};
+    for(int i{}; i < vocabularySize; i++)
+    {
+        total += 1.0 / (i + 1);
+        cumulative.push_back(total);
+    }
+    std::uniform_real_distribution<double> uniform{0.0, total};
+
+    for(int d{}; d < numDocs; d++)
+    {
+        std::string text;
+        for(int w{}; w < wordsPerDoc; w++)
+        {
+            int rank = std::lower_bound(cumulative.begin(), cumulative.end(),
+                                        uniform(random)) - cumulative.begin();
+            text += vocabulary[std::min(rank, vocabularySize - 1)];
+            text += (w % 15 == 14) ? ". " : " ";
+        }
+        texts.push_back(text);
+
+        ParsedDocument document;
+        document.file = "synthetic/doc" + std::to_string(d) + ".pdf";
+        document.pages = 1 + wordsPerDoc / 500;
+        std::vector<std::string> words;
+        Parser::tokenize(text, words);
+        document.terms.add(words);
+        document.terms.partition();
+        documents.push_back(document);
+    }
+
+    size_t bytes{};
+    for(std::string& text : texts)
+        bytes += text.size();
+
+    record("corpus", "documents", documents.size());
+    record("corpus", "bytes", bytes);
+}
+
+/**
+ *
+ * extractCorpus()
+ *
+ * Extracts and tokenizes every PDF within the corpus directory on the
+ * Parser's worker threads, timing the extraction. The text of a PDF isn't
+ * kept, so the tokenize benchmark runs on the counted words of each part
+ * instead, every occurrence written out.
+ */
+void Benchmark::extractCorpus()
+{
+    std::vector<std::string> files;
+    Parser::getFileList(corpus, files);
+
+    int pages{};
+    size_t words{};
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    {
+        //Large PDFs are handed back in parts, which are inserted in order
+        IngestPool pool{files, Parser::getNumThreads()};
+        ParsedDocument part;
+        while(pool.next(part))
+        {
+            pages += part.pages;
+            words += part.terms.getNumWords();
+            documents.push_back(part);
+        }
+    }
+    double milliseconds = elapsed(start);
+
+    record("extract", "files", files.size());
+    record("extract", "threads", Parser::getNumThreads());
+    record("extract", "ms", milliseconds);
+    record("extract", "pages_per_s", pages / milliseconds * 1000);
+    record("extract", "words_per_s", words / milliseconds * 1000);
+
+    for(ParsedDocument& document : documents)
+    {
+        std::string text;
+        for(LocalIndex::Term& term : document.terms.getTerms())
+        {
+            for(uint32_t i{}; i < term.frequency; i++)
+                text += term.word + " ";
+        }
+        texts.push_back(text);
+    }
+}
+
+/**
+ *
+ * generateQueries(IndexInterface*)
+ *
+ * Generates the AND, OR, NOT, and nested queries from the words of an
+ * index. Half of the terms are drawn from the most frequent words and half
+ * from every word, so the queries mix long and short posting lists, and
+ * the planner has conjunctions to reorder.
+ *
+ * @param index - the index to draw the words from
+ */
+void Benchmark::generateQueries(IndexInterface* index)
+{
+    std::vector<Word*> words;
+    index->getWords(words);
+    if(words.empty())
+        return;
+
+    std::sort(words.begin(), words.end(), [](Word* lhs, Word* rhs)
+    {
+        return lhs->getTotalFrequency() > rhs->getTotalFrequency();
+    });
+
+    std::mt19937 random{seed};
+    int numFrequent = std::max(1, std::min(200, (int) words.size() / 100));
+    auto pick = [&]()
+    {
+        int range = (random() % 2 == 0) ? numFrequent : words.size();
+        return words[random() % range]->getWord();
+    };
+
+    queryTypes = {"and", "or", "not", "nested"};
+    queries.assign(4, std::vector<std::string>());
+    for(int i{}; i < numQueries; i++)
+    {
+        queries[0].push_back("AND " + pick() + " " + pick());
+        queries[1].push_back("OR " + pick() + " " + pick());
+        queries[2].push_back("AND " + pick() + " " + pick() + " NOT " + pick());
+        queries[3].push_back("(" + pick() + " OR " + pick() + ") AND " + pick() + " "
+                             + pick() + " " + pick() + " NOT " + pick());
+    }
+}
+
+/**
+ *
+ * benchmarkTokenize()
+ *
+ * Measures the throughput of splitting the corpus text into stemmed words,
+ * and of stemming alone on the raw words of the text.
+ */
+void Benchmark::benchmarkTokenize()
+{
+    size_t bytes{}, words{};
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    for(std::string& text : texts)
+    {
+        bytes += text.size();
+        std::vector<std::string> tokens;
+        Parser::tokenize(text, tokens);
+        words += tokens.size();
+    }
+    double milliseconds = elapsed(start);
+
+    record("tokenize", "ms", milliseconds);
+    record("tokenize", "mb_per_s", bytes / milliseconds / 1000);
+    record("tokenize", "words_per_s", words / milliseconds * 1000);
+
+    //Lowercase words of the text, which are stemmed in place
+    std::vector<std::string> raw;
+    for(std::string& text : texts)
+    {
+        std::string str;
+        for(char c : text)
+        {
+            if(std::isalpha((unsigned char) c))
+            {
+                str += std::tolower((unsigned char) c);
+            }
+            else if(!str.empty() && raw.size() < 1000000)
+            {
+                raw.push_back(str);
+                str.clear();
+            }
+        }
+    }
+
+    start = std::chrono::high_resolution_clock::now();
+    for(std::string& str : raw)
+        Porter2Stemmer::stem(str);
+    milliseconds = elapsed(start);
+
+    record("stem", "ms", milliseconds);
+    record("stem", "words_per_s", raw.size() / milliseconds * 1000);
+}
+
+/**
+ *
+ * benchmarkInsert(IndexInterface*)
+ *
+ * Measures the time taken to insert every parsed document of the corpus
+ * into an empty index, merging MERGE_BATCH documents at a time as a parse
+ * does. A SegmentedIndex writes a segment each time its buffer fills, so
+ * its time includes writing them.
+ *
+ * @param index - the empty index to insert into
+ */
+void Benchmark::benchmarkInsert(IndexInterface* index)
+{
+    resetParser();
+    index->setIndexDirectory(corpus.empty() ? "synthetic" : corpus);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    std::vector<ParsedDocument*> batch;
+    for(ParsedDocument& document : documents)
+    {
+        batch.push_back(&document);
+        if((int) batch.size() == Parser::MERGE_BATCH || &document == &documents.back())
+        {
+            Parser::indexDocuments(batch, index);
+            batch.clear();
+        }
+    }
+    double milliseconds = elapsed(start);
+
+    std::vector<Word*> words;
+    index->getWords(words);
+
+    std::string name = "insert_" + getName(index);
+    record(name, "ms", milliseconds);
+    record(name, "words_per_s", Parser::getNumWords() / milliseconds * 1000);
+    record(name, "terms", words.size());
+}
+
+/**
+ *
+ * benchmarkSave(IndexInterface*)
+ *
+ * Measures the time taken to write an index to the index file. A
+ * SegmentedIndex only writes the words still in its buffer as a segment,
+ * followed by the manifest, so its size includes every segment.
+ *
+ * @param index - the index to save
+ */
+void Benchmark::benchmarkSave(IndexInterface* index)
+{
+    index->setIndexFile(indexFile);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    index->printToFile();
+    double milliseconds = elapsed(start);
+
+    std::string name = "save_" + getName(index);
+    record(name, "ms", milliseconds);
+    record(name, "bytes", getIndexSize());
+}
+
+/**
+ *
+ * benchmarkUpdate(IndexInterface*)
+ *
+ * Measures the time taken to add MERGE_BATCH documents to a saved index
+ * and save it again, as adding PDFs to an index does. A SegmentedIndex only
+ * writes their words as a new segment, while the other indexes rewrite the
+ * whole index file. The documents are copies of the first documents of the
+ * corpus under new names.
+ *
+ * @param index - the saved index to add to
+ */
+void Benchmark::benchmarkUpdate(IndexInterface* index)
+{
+    size_t count = std::min((size_t) Parser::MERGE_BATCH, documents.size());
+    std::vector<ParsedDocument> added(documents.begin(), documents.begin() + count);
+    std::vector<ParsedDocument*> batch;
+    for(ParsedDocument& document : added)
+    {
+        document.file += ".update";
+        batch.push_back(&document);
+    }
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    Parser::indexDocuments(batch, index);
+    double inserting = elapsed(start);
+    index->printToFile();
+    double milliseconds = elapsed(start);
+
+    std::string name = "update_" + getName(index);
+    record(name, "insert_ms", inserting);
+    record(name, "save_ms", milliseconds - inserting);
+    record(name, "bytes", getIndexSize());
+}
+
+/**
+ *
+ * benchmarkLoad(IndexInterface*)
+ *
+ * Measures the time taken to load an index from the index file, and the
+ * time until the first query has been answered. A MappedIndex only maps
+ * the file, so its load time doesn't include decoding any words, and its
+ * first query decodes only the words it searches for.
+ *
+ * @param index - the empty index to load into
+ */
+void Benchmark::benchmarkLoad(IndexInterface* index)
+{
+    index->setIndexFile(indexFile);
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    bool loaded = index->load();
+    double milliseconds = elapsed(start);
+
+    std::string name = "load_" + getName(index);
+    record(name, "ms", loaded ? milliseconds : -1);
+
+    if(loaded && !queries.empty() && !queries[0].empty())
+    {
+        std::cerr.setstate(std::ios::failbit);
+        QueryProcessor::process(queries[0][0], index).getTopDocs(NUM_DOCS);
+        std::cerr.clear();
+        record(name, "first_query_ms", elapsed(start));
+    }
+}
+
+/**
+ *
+ * benchmarkQueries(IndexInterface*)
+ *
+ * Measures the latency of each query, including ranking the top documents,
+ * and records the mean and the 50th, 90th, and 99th percentiles and maximum
+ * in microseconds for each type of query.
+ *
+ * @param index - the index to search
+ */
+void Benchmark::benchmarkQueries(IndexInterface* index)
+{
+    //Skipped words would be reported on std::cerr
+    std::cerr.setstate(std::ios::failbit);
+
+    for(int type{}; type < (int) queries.size(); type++)
+    {
+        std::vector<double> latencies;
+        size_t results{};
+        for(std::string& query : queries[type])
+        {
+            std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            Word word{QueryProcessor::process(query, index)};
+            results += word.getTopDocs(NUM_DOCS).size();
+            latencies.push_back(elapsed(start) * 1000);
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+        double total{};
+        for(double latency : latencies)
+            total += latency;
+
+        std::string name = "query_" + queryTypes[type] + "_" + getName(index);
+        record(name, "mean_us", total / latencies.size());
+        record(name, "p50_us", latencies[latencies.size() * 50 / 100]);
+        record(name, "p90_us", latencies[latencies.size() * 90 / 100]);
+        record(name, "p99_us", latencies[latencies.size() * 99 / 100]);
+        record(name, "max_us", latencies.back());
+        record(name, "results", (double) results / latencies.size());
+    }
+
+    std::cerr.clear();
+}
+
+/**
+ *
+ * benchmarkCachedQueries(IndexInterface*)
+ *
+ * Runs the AND queries through QueryProcessor::search() twice on an empty
+ * result cache. The first run searches the index and fills the cache, and
+ * the second is answered from it. Records the median latency of each run,
+ * the 99th percentile of the cached run, and the share of the second run
+ * found in the cache.
+ *
+ * @param index - the index to search
+ */
+void Benchmark::benchmarkCachedQueries(IndexInterface* index)
+{
+    if(queries.empty())
+        return;
+    std::cerr.setstate(std::ios::failbit);
+    QueryProcessor::results.clear();
+
+    std::vector<std::vector<double>> runs(2);
+    uint64_t hits{};
+    for(std::vector<double>& latencies : runs)
+    {
+        hits = QueryProcessor::results.getNumHits();
+        for(std::string& query : queries[0])
+        {
+            std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+            QueryProcessor::search(query, index, NUM_DOCS);
+            latencies.push_back(elapsed(start) * 1000);
+        }
+        std::sort(latencies.begin(), latencies.end());
+    }
+    hits = QueryProcessor::results.getNumHits() - hits;
+    QueryProcessor::results.clear();
+    std::cerr.clear();
+
+    std::string name = "query_cached_" + getName(index);
+    record(name, "first_p50_us", runs[0][runs[0].size() * 50 / 100]);
+    record(name, "cached_p50_us", runs[1][runs[1].size() * 50 / 100]);
+    record(name, "cached_p99_us", runs[1][runs[1].size() * 99 / 100]);
+    record(name, "hit_rate", (double) hits / runs[1].size());
+}
+
+/**
+ *
+ * benchmarkConcurrentQueries()
+ *
+ * Inserts the corpus into an empty HashIndex, publishing a snapshot after
+ * every batch of documents, while one reader for each of the Parser's
+ * threads runs the AND queries on the latest snapshot. Records the latency
+ * percentiles of the queries, the number of queries answered per second,
+ * and the time taken to insert the corpus and to publish the snapshots
+ * under that load. A parse publishes far less often than this, once every
+ * PUBLISH_INTERVAL_MS.
+ */
+void Benchmark::benchmarkConcurrentQueries()
+{
+    std::cerr.setstate(std::ios::failbit);
+
+    resetParser();
+    IndexInterface* index = new HashIndex();
+    index->setIndexDirectory(corpus.empty() ? "synthetic" : corpus);
+    index->publish();
+
+    std::atomic<bool> inserting{true};
+    std::mutex lock;
+    std::vector<double> latencies;
+
+    std::vector<std::thread> readers;
+    for(int r{}; r < Parser::getNumThreads(); r++)
+    {
+        readers.push_back(std::thread([this, r, index, &inserting, &lock, &latencies]
+        {
+            std::vector<double> own;
+            const std::vector<std::string>& list = queries[0];
+            for(size_t i = r; inserting; i++)
+            {
+                std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+                std::shared_ptr<const IndexSnapshot> snapshot{index->getSnapshot()};
+                Word word{QueryProcessor::process(list[i % list.size()], *snapshot)};
+                snapshot->getTopDocs(word, NUM_DOCS);
+                own.push_back(elapsed(start) * 1000);
+            }
+
+            std::lock_guard<std::mutex> guard(lock);
+            latencies.insert(latencies.end(), own.begin(), own.end());
+        }));
+    }
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    std::vector<ParsedDocument*> batch;
+    double publishing{};
+    for(ParsedDocument& document : documents)
+    {
+        batch.push_back(&document);
+        if((int) batch.size() == Parser::MERGE_BATCH || &document == &documents.back())
+        {
+            Parser::indexDocuments(batch, index);
+            batch.clear();
+
+            std::chrono::high_resolution_clock::time_point published = std::chrono::high_resolution_clock::now();
+            index->publish();
+            publishing += elapsed(published);
+        }
+    }
+    double milliseconds = elapsed(start);
+    uint64_t snapshots{index->getSnapshot()->getVersion()};
+
+    inserting = false;
+    for(std::thread& reader : readers)
+        reader.join();
+    delete index;
+    std::cerr.clear();
+
+    if(latencies.empty())
+        return;
+    std::sort(latencies.begin(), latencies.end());
+
+    record("concurrent", "readers", readers.size());
+    record("concurrent", "insert_ms", milliseconds - publishing);
+    record("concurrent", "publish_ms", publishing);
+    record("concurrent", "snapshots", snapshots);
+    record("concurrent", "queries_per_s", latencies.size() / milliseconds * 1000);
+    record("concurrent", "p50_us", latencies[latencies.size() * 50 / 100]);
+    record("concurrent", "p99_us", latencies[latencies.size() * 99 / 100]);
+    record("concurrent", "max_us", latencies.back());
+}
+
+/**
+ *
+ * benchmarkServer()
+ *
+ * Inserts the corpus into a HashIndex, publishes it, and serves it with a
+ * SearchServer on a Unix domain socket, with one worker for each of the
+ * Parser's threads. Four clients for each worker connect at once, and each
+ * sends every type of query in turn, waiting for the answer to one before
+ * sending the next. Records the number of queries answered per second and
+ * the latency percentiles seen by the clients, which include the socket
+ * round trip and the queueing of queries behind each other.
+ */
+void Benchmark::benchmarkServer()
+{
+    if(queries.empty())
+        return;
+    std::cerr.setstate(std::ios::failbit);
+
+    resetParser();
+    IndexInterface* index = new HashIndex();
+    index->setIndexDirectory(corpus.empty() ? "synthetic" : corpus);
+    std::vector<ParsedDocument*> batch;
+    for(ParsedDocument& document : documents)
+    {
+        batch.push_back(&document);
+        if((int) batch.size() == Parser::MERGE_BATCH || &document == &documents.back())
+        {
+            Parser::indexDocuments(batch, index);
+            batch.clear();
+        }
+    }
+    index->publish();
+
+    std::string path = (std::experimental::filesystem::temp_directory_path() / "IndexBench.sock").string();
+    SearchServer server{index, "json", NUM_DOCS, Parser::getNumThreads()};
+    if(!server.listenUnix(path))
+    {
+        delete index;
+        std::cerr.clear();
+        return;
+    }
+    std::thread serving(&SearchServer::run, &server);
+
+    std::atomic<bool> failed{false};
+    std::mutex lock;
+    std::vector<double> latencies;
+
+    std::chrono::high_resolution_clock::time_point start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> clients;
+    for(int c{}; c < server.getNumWorkers() * 4; c++)
+    {
+        clients.push_back(std::thread([this, c, &path, &failed, &lock, &latencies]
+        {
+            sockaddr_un address{};
+            address.sun_family = AF_UNIX;
+            std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+            int client = socket(AF_UNIX, SOCK_STREAM, 0);
+            if(client < 0 || connect(client, (sockaddr*) &address, sizeof(address)) != 0)
+            {
+                failed = true;
+                if(client >= 0)
+                    close(client);
+                return;
+            }
+
+            //Every answer is a single line of JSON
+            std::vector<double> own;
+            std::string received;
+            char buffer[65536];
+            for(int i{}; i < numQueries && !failed; i++)
+            {
+                const std::vector<std::string>& list = queries[(c + i) % queries.size()];
+                std::string line = list[(c + i * 7) % list.size()] + "\n";
+
+                std::chrono::high_resolution_clock::time_point sent = std::chrono::high_resolution_clock::now();
+                if(send(client, line.data(), line.size(), MSG_NOSIGNAL) != (ssize_t) line.size())
+                    failed = true;
+
+                size_t end{};
+                while(!failed && (end = received.find('\n')) == std::string::npos)
+                {
+                    ssize_t length = recv(client, buffer, sizeof(buffer), 0);
+                    if(length <= 0)
+                        failed = true;
+                    else
+                        received.append(buffer, length);
+                }
+                if(failed)
+                    break;
+
+                received.erase(0, end + 1);
+                own.push_back(elapsed(sent) * 1000);
+            }
+            close(client);
+
+            std::lock_guard<std::mutex> guard(lock);
+            latencies.insert(latencies.end(), own.begin(), own.end());
+        }));
+    }
+
+    for(std::thread& client : clients)
+        client.join();
+    double milliseconds = elapsed(start);
+
+    server.stop();
+    serving.join();
+    delete index;
+    std::cerr.clear();
+
+    if(failed || latencies.empty())
+    {
+        std::cerr << "The server benchmark failed." << std::endl;
+        return;
+    }
+    std::sort(latencies.begin(), latencies.end());
+
+    record("server", "clients", clients.size());
+    record("server", "workers", server.getNumWorkers());
+    record("server", "queries_per_s", latencies.size() / milliseconds * 1000);
+    record("server", "p50_us", latencies[latencies.size() * 50 / 100]);
+    record("server", "p99_us", latencies[latencies.size() * 99 / 100]);
+    record("server", "max_us", latencies.back());
+}
+
+/**
+ * resetParser()
+ *
+ * Clears the counters and document table of the Parser, so every index is
+ * built from the same starting point.
+ */
+void Benchmark::resetParser()
+{
+    Parser::documents.clear();
+    Parser::setNumFiles(documents.size());
+    Parser::setNumPages(0);
+    Parser::setNumWords(0);
+}
+
+/**
+ * newIndex(int)
+ *
+ * @param type  - 0 for a SegmentedIndex, 1 for a HashIndex, 2 for an AVLIndex
+ * @return      - a new, empty index of that type
+ */
+IndexInterface* Benchmark::newIndex(int type)
+{
+    if(type == 0)
+        return new SegmentedIndex();
+    if(type == 1)
+        return new HashIndex();
+    return new AVLIndex();
+}
+
+/**
+ * getIndexSize()
+ *
+ * @return  - the size of the index file and of every segment it lists, in
+ *            bytes
+ */
+double Benchmark::getIndexSize()
+{
+    namespace fs = std::experimental::filesystem;
+
+    std::error_code error;
+    double bytes = fs::file_size(indexFile, error);
+
+    IndexFile file;
+    if(file.open(indexFile))
+    {
+        for(const std::string& segment : file.getSegments())
+        {
+            uintmax_t size = fs::file_size(segment, error);
+            bytes += error ? 0 : size;
+        }
+    }
+    return bytes;
+}
+
+/**
+ * removeIndexFiles()
+ *
+ * Deletes the index file and every segment named after it.
+ */
+void Benchmark::removeIndexFiles()
+{
+    namespace fs = std::experimental::filesystem;
+
+    std::string prefix = fs::path(indexFile).filename().string() + ".";
+    std::vector<fs::path> files;
+    for(const fs::directory_entry& entry : fs::directory_iterator(fs::path(indexFile).parent_path()))
+    {
+        if(entry.path().filename().string().compare(0, prefix.size(), prefix) == 0)
+            files.push_back(entry.path());
+    }
+    for(const fs::path& file : files)
+        fs::remove(file);
+    fs::remove(indexFile);
+}
+
+/**
+ * getName(IndexInterface*)
+ *
+ * @param index - the index to name
+ * @return      - the data type of the index in lowercase, with spaces
+ *                replaced by underscores, such as "hash_table"
+ */
+std::string Benchmark::getName(IndexInterface* index)
+{
+    std::string name = index->getDataType();
+    for(char& c : name)
+        c = (c == ' ') ? '_' : std::tolower(c);
+    return name;
+}
+
+/**
+ * record(const std::string&, const std::string&, double)
+ *
+ * @param name      - the name of the benchmark
+ * @param metric    - the name of the measurement
+ * @param value     - the measured value
+ */
+void Benchmark::record(const std::string& name, const std::string& metric, double value)
+{
+    names.push_back(name);
+    metrics.push_back(metric);
+    values.push_back(value);
+}
+
+/**
+ *
+ * printResults()
+ *
+ * Outputs the results to std::cout, one per line as
+ *  <benchmark>\t<metric>\t<value>
+ * or as a single JSON object.
+ */
+void Benchmark::printResults()
+{
+    std::cout << std::setprecision(10);
+    if(format == "json")
+    {
+        std::cout << "{\"results\":[";
+        for(int i{}; i < (int) values.size(); i++)
+        {
+            if(i != 0)
+                std::cout << ",";
+            std::cout << "{\"benchmark\":\"" << names[i] << "\",";
+            std::cout << "\"metric\":\"" << metrics[i] << "\",";
+            std::cout << "\"value\":" << values[i] << "}";
+        }
+        std::cout << "]}" << std::endl;
+    }
+    else
+    {
+        for(int i{}; i < (int) values.size(); i++)
+            std::cout << names[i] << "\t" << metrics[i] << "\t" << values[i] << "\n";
+        std::cout.flush();
+    }
+}
+
+/**
+ * printUsage()
+ *
+ * Outputs the usage of the program to std::cerr
+ */
+void Benchmark::printUsage()
+{
+    std::cerr << "Usage: IndexBench [--corpus <dir>] [--docs N] [--words N] "
+                 "[--vocabulary N]\n"
+                 "                  [--queries N] [--seed N] [--threads N] "
+                 "[--format tsv|json]\n";
+}
+
+/**
+ * elapsed(high_resolution_clock::time_point)
+ *
+ * @param start - the point in time to measure from
+ * @return      - the milliseconds since the point in time
+ */
+double Benchmark::elapsed(std::chrono::high_resolution_clock::time_point start)
+{
+    std::chrono::duration<double, std::milli> milliseconds
+            = std::chrono::high_resolution_clock::now() - start;
+    return milliseconds.count();
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+#include <Index/indexinterface.h>
+#include <Index/avlindex.h>
+#include <Index/hashindex.h>
+#include <Index/mappedindex.h>
+#include <Index/segmentedindex.h>
+#include <Parser/parser.h>
+#include <QueryProcessor/queryprocessor.h>
+#include <Server/searchserver.h>
+
+/**
+ * The Benchmark class measures the main paths of the PDF search engine,
+ * so changes can be checked for regressions and the index data structures
+ * can be compared with each other:
+ *
+ *  tokenize    - splitting text into stemmed words, and stemming alone
+ *  insert      - building a SegmentedIndex, a HashIndex, and an AVLIndex from
+ *                parsed documents
+ *  save/load   - writing each index to the index file, loading it back, and
+ *                the time until the first query is answered
+ *  update      - adding a batch of documents to a saved index and saving it
+ *                again, which only writes a new segment for a SegmentedIndex
+ *  query       - latency percentiles of AND, OR, and NOT queries on each index
+ *  cached      - latency of queries answered from the result cache, and of
+ *                the first run of each query, which fills it
+ *  concurrent  - latency of queries on snapshots, on every thread, while the
+ *                corpus is inserted into a HashIndex and published
+ *  server      - throughput and latency of queries sent to a SearchServer
+ *                over a Unix domain socket by several clients at once
+ *
+ * The corpus is either a directory of PDFs, or a synthetic corpus whose
+ * words follow a Zipf distribution, generated from a fixed seed so runs
+ * can be compared with each other.
+ *
+ * Usage: IndexBench [options]
+ *
+ * Options:
+ *  --corpus <dir>      - benchmark a directory of PDFs instead of a synthetic corpus
+ *  --docs N            - the number of synthetic documents (default 1000)
+ *  --words N           - the number of words in each synthetic document (default 2000)
+ *  --vocabulary N      - the number of distinct synthetic words (default 50000)
+ *  --queries N         - the number of queries of each type (default 1000)
+ *  --seed N            - the seed of the synthetic corpus and queries (default 1)
+ *  --threads N         - the number of threads used to parse PDFs
+ *  --format tsv|json   - the output format (default tsv)
+ *
+ * By: Oisin Coveney
+ */
+class Benchmark
+{
+    private:
+
+        //Options
+        std::string corpus;
+        int numDocs{1000};
+        int wordsPerDoc{2000};
+        int vocabularySize{50000};
+        int numQueries{1000};
+        unsigned int seed{1};
+        std::string format{"tsv"};
+
+        //The corpus, as text and as parsed documents
+        std::vector<std::string> texts;
+        std::vector<ParsedDocument> documents;
+
+        //Queries of each type, and the index file used for saving
+        std::vector<std::string> queryTypes;
+        std::vector<std::vector<std::string>> queries;
+        std::string indexFile;
+
+        //Results, as benchmark, metric, and value
+        std::vector<std::string> names;
+        std::vector<std::string> metrics;
+        std::vector<double> values;
+
+        //Parses the options from the arguments
+        bool parseArguments(int argc, char** argv);
+
+        //Creates the corpus
+        void generateCorpus();
+        void extractCorpus();
+        void generateQueries(IndexInterface* index);
+
+        //Benchmarks
+        void benchmarkTokenize();
+        void benchmarkInsert(IndexInterface* index);
+        void benchmarkSave(IndexInterface* index);
+        void benchmarkUpdate(IndexInterface* index);
+        void benchmarkLoad(IndexInterface* index);
+        void benchmarkQueries(IndexInterface* index);
+        void benchmarkCachedQueries(IndexInterface* index);
+        void benchmarkConcurrentQueries();
+        void benchmarkServer();
+
+        //Resets the counters and document table of the Parser
+        void resetParser();
+
+        //Index files
+        static IndexInterface* newIndex(int type);
+        double getIndexSize();
+        void removeIndexFiles();
+
+        //Output
+        static std::string getName(IndexInterface* index);
+        void record(const std::string& name, const std::string& metric, double value);
+        void printResults();
+        void printUsage();
+
+        //Milliseconds since a point in time
+        static double elapsed(std::chrono::high_resolution_clock::time_point start);
+
+    public:
+
+        //Runs the benchmarks given by the arguments, returning the exit code
+        int run(int argc, char** argv);
+};
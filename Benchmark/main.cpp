@@ -0,0 +1,7 @@
+#include <Benchmark/benchmark.h>
+
+int main(int argc, char** argv)
+{
+    Benchmark benchmark{};
+    return benchmark.run(argc, argv);
+}
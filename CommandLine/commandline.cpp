@@ -0,0 +1,432 @@
+#include <CommandLine/commandline.h>
+
+/**
+ * Destructor
+ */
+CommandLine::~CommandLine()
+{
+    if(index != nullptr)
+        delete index;
+}
+
+/**
+ *
+ * run(int, char**)
+ *
+ * Parses the arguments, creates the index, and runs the command. The index,
+ * add, remove, refresh, and serve commands use the chosen data structure, while search and stats
+ * use a MappedIndex, so only the words that are searched for are read. A
+ * SegmentedIndex only writes the words that were added as a new segment.
+ *
+ * @param argc  - the number of arguments
+ * @param argv  - the arguments given to the program
+ * @return      - 0 on success, 1 for invalid arguments, 2 if the command fails
+ */
+int CommandLine::run(int argc, char** argv)
+{
+    if(!parseArguments(argc, argv))
+    {
+        printUsage();
+        return 1;
+    }
+
+    //Read-only commands search the index file in place
+    if(command == "search" || command == "stats")
+        index = new MappedIndex();
+    else if(type == "avl")
+        index = new AVLIndex();
+    else if(type == "hash")
+        index = new HashIndex();
+    else
+        index = new SegmentedIndex();
+
+    if(command == "index")
+        return indexDirectory();
+    else if(command == "add")
+        return addPath();
+    else if(command == "refresh")
+        return refreshIndex();
+    else if(command == "remove")
+        return removePath();
+    else if(command == "search")
+        return search();
+    else if(command == "serve")
+        return serve();
+    else
+        return stats();
+}
+
+/**
+ *
+ * parseArguments(int, char**)
+ *
+ * Reads the options and the command from the program arguments.
+ *
+ * @param argc  - the number of arguments
+ * @param argv  - the arguments given to the program
+ * @return      - true if the arguments are valid, false if not
+ */
+bool CommandLine::parseArguments(int argc, char** argv)
+{
+    std::vector<std::string> args;
+    for(int i{1}; i < argc; i++)
+    {
+        std::string arg{argv[i]};
+
+        //Options take the next argument as their value
+        if(arg == "--type" || arg == "--format" || arg == "--threads" || arg == "--limit"
+                || arg == "--socket" || arg == "--port")
+        {
+            if(i + 1 >= argc)
+                return false;
+
+            std::string value{argv[++i]};
+            if(arg == "--type")
+                type = value;
+            else if(arg == "--format")
+                format = value;
+            else if(arg == "--limit")
+                limit = std::atoi(value.c_str());
+            else if(arg == "--socket")
+                socketPath = value;
+            else if(arg == "--port")
+                port = std::atoi(value.c_str());
+            else
+                Parser::setNumThreads(std::atoi(value.c_str()));
+        }
+        else
+        {
+            args.push_back(arg);
+        }
+    }
+
+    if((type != "hash" && type != "avl" && type != "segmented") || (format != "tsv" && format != "json") || limit < 1)
+        return false;
+
+    if(port < 0 || port > 65535 || (port != 0 && !socketPath.empty()))
+        return false;
+
+    if(args.empty())
+        return false;
+
+    command = args[0];
+    if(command == "stats" || command == "serve")
+        return args.size() == 1;
+    else if(command == "refresh")
+    {
+        if(args.size() > 2)
+            return false;
+        if(args.size() == 2)
+            argument = args[1];
+        return true;
+    }
+    else if(command == "index" || command == "add" || command == "remove" || command == "search")
+    {
+        if(args.size() != 2)
+            return false;
+        argument = args[1];
+        return true;
+    }
+    return false;
+}
+
+/**
+ *
+ * indexDirectory()
+ *
+ * Builds the index from the directory given as the argument, saves it to
+ * the index file, and prints the statistics of the new index.
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::indexDirectory()
+{
+    if(!std::experimental::filesystem::is_directory(argument))
+    {
+        printError("The directory " + argument + " does not exist.");
+        return 2;
+    }
+
+    Parser::parse(argument, index);
+    index->printToFile();
+    return stats();
+}
+
+/**
+ *
+ * addPath()
+ *
+ * Loads the persistent index and adds the PDF or directory of PDFs given as
+ * the argument, then saves the index and prints its statistics.
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::addPath()
+{
+    namespace fs = std::experimental::filesystem;
+    if(!fs::exists(argument))
+    {
+        printError("The path " + argument + " does not exist.");
+        return 2;
+    }
+
+    if(!loadIndex())
+        return 2;
+
+    if(fs::is_directory(argument))
+        Parser::addExtraDirectory(argument, index);
+    else
+        Parser::addExtraDoc(argument, index);
+
+    index->printToFile();
+    return stats();
+}
+
+/**
+ *
+ * removePath()
+ *
+ * Loads the persistent index and removes the PDF given as the argument,
+ * then saves the index and prints its statistics. The PDF is left as a
+ * tombstone, which is compacted away once enough PDFs have been removed.
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::removePath()
+{
+    if(!loadIndex())
+        return 2;
+
+    std::string file = std::experimental::filesystem::absolute(argument);
+    if(!index->removeDocument(file))
+    {
+        printError("The file " + file + " is not in the index.");
+        return 2;
+    }
+
+    index->printToFile();
+    return stats();
+}
+
+/**
+ *
+ * refreshIndex()
+ *
+ * Loads the persistent index and brings it up to date with the files on
+ * disk, parsing only the PDFs that are new or have changed and removing
+ * the PDFs that have been deleted. New PDFs are searched for in the
+ * directory given as the argument, or in the indexed directory if there
+ * is none. The index is then saved and its statistics printed.
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::refreshIndex()
+{
+    if(!loadIndex())
+        return 2;
+
+    std::string directory = argument.empty() ? index->getIndexDirectory() : argument;
+    if(!std::experimental::filesystem::is_directory(directory))
+    {
+        printError("The directory " + directory + " does not exist.");
+        return 2;
+    }
+
+    Parser::refresh(directory, index);
+    index->printToFile();
+    return stats();
+}
+
+/**
+ *
+ * search()
+ *
+ * Loads the persistent index and runs the query given as the argument,
+ * printing the highest ranked documents with their frequency and ranking.
+ *
+ * TSV output has one document per line:
+ *  <document>\t<frequency>\t<ranking>
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::search()
+{
+    if(!loadIndex())
+        return 2;
+
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    QueryResult result{QueryProcessor::search(argument, index, limit)};
+    std::vector<DocDetails>& docs = result.docs;
+    high_resolution_clock::time_point t2 = high_resolution_clock::now();
+    duration<double, std::milli> milliseconds = t2 - t1;
+
+    if(format == "json")
+    {
+        std::cout << "{\"query\":\"" << SearchServer::escape(argument) << "\",";
+        std::cout << "\"terms\":\"" << SearchServer::escape(result.terms) << "\",";
+        std::cout << "\"milliseconds\":" << milliseconds.count() << ",";
+        std::cout << "\"matches\":" << result.matches << ",";
+        std::cout << "\"results\":[";
+        for(int i{}; i < (int) docs.size(); i++)
+        {
+            if(i != 0)
+                std::cout << ",";
+            std::cout << "{\"document\":\"" << SearchServer::escape(Parser::documents.getPath(docs[i].id)) << "\",";
+            std::cout << "\"frequency\":" << docs[i].frequency << ",";
+            std::cout << "\"ranking\":" << docs[i].ranking << "}";
+        }
+        std::cout << "]}" << std::endl;
+    }
+    else
+    {
+        for(DocDetails& d : docs)
+            std::cout << Parser::documents.getPath(d.id) << "\t" << d.frequency << "\t" << d.ranking << "\n";
+        std::cout.flush();
+    }
+    return 0;
+}
+
+/**
+ *
+ * serve()
+ *
+ * Loads the persistent index once, publishes it, and answers queries from
+ * clients with a SearchServer until SIGINT or SIGTERM is received. The
+ * server listens on the TCP port given with --port, on localhost only, or
+ * on the Unix domain socket given with --socket, index.sock by default.
+ * Queries are answered on one worker thread for each of the Parser's
+ * threads.
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::serve()
+{
+    if(!loadIndex())
+        return 2;
+    index->publish();
+
+    SearchServer server{index, format, limit, Parser::getNumThreads()};
+    std::string address = (port != 0) ? "localhost:" + std::to_string(port)
+                                      : (socketPath.empty() ? "index.sock" : socketPath);
+    bool listening = (port != 0) ? server.listenTcp(port) : server.listenUnix(address);
+    if(!listening)
+    {
+        printError("Could not listen on " + address + ": " + std::strerror(errno));
+        return 2;
+    }
+
+    std::cerr << "Serving " << Parser::getNumFiles() << " files on " << address << " with "
+              << server.getNumWorkers() << " workers" << std::endl;
+    server.run();
+    std::cerr << "Answered " << server.getNumQueries() << " queries from "
+              << server.getNumAccepted() << " connections" << std::endl;
+    return 0;
+}
+
+/**
+ *
+ * stats()
+ *
+ * Prints the number of files, pages, and words in the index and the list
+ * of most frequent words. If no index has been built or loaded yet, the
+ * persistent index is loaded first.
+ *
+ * TSV output has one statistic per line, followed by one line per
+ * frequent word:
+ *  <name>\t<value>
+ *  frequent\t<word>\t<frequency>
+ *
+ * @return  - the exit code of the command
+ */
+int CommandLine::stats()
+{
+    if(index->empty() && !loadIndex())
+        return 2;
+
+    std::vector<Word*> frequentWords{index->getFrequentWords()};
+
+    if(format == "json")
+    {
+        std::cout << "{\"directory\":\"" << SearchServer::escape(index->getIndexDirectory()) << "\",";
+        std::cout << "\"type\":\"" << index->getDataType() << "\",";
+        std::cout << "\"files\":" << Parser::getNumFiles() << ",";
+        std::cout << "\"pages\":" << Parser::getNumPages() << ",";
+        std::cout << "\"words\":" << Parser::getNumWords() << ",";
+        std::cout << "\"frequentWords\":[";
+        for(int i{}; i < (int) frequentWords.size(); i++)
+        {
+            if(i != 0)
+                std::cout << ",";
+            std::cout << "{\"word\":\"" << SearchServer::escape(frequentWords[i]->getWord()) << "\",";
+            std::cout << "\"frequency\":" << frequentWords[i]->getTotalFrequency() << "}";
+        }
+        std::cout << "]}" << std::endl;
+    }
+    else
+    {
+        std::cout << "directory\t" << index->getIndexDirectory() << "\n";
+        std::cout << "type\t" << index->getDataType() << "\n";
+        std::cout << "files\t" << Parser::getNumFiles() << "\n";
+        std::cout << "pages\t" << Parser::getNumPages() << "\n";
+        std::cout << "words\t" << Parser::getNumWords() << "\n";
+        for(Word* w : frequentWords)
+            std::cout << "frequent\t" << w->getWord() << "\t" << w->getTotalFrequency() << "\n";
+        std::cout.flush();
+    }
+    return 0;
+}
+
+/**
+ *
+ * loadIndex()
+ *
+ * Loads the index from the persistent index file.
+ *
+ * @return  - false if there is no valid index file, true otherwise
+ */
+bool CommandLine::loadIndex()
+{
+    if(index->getDirectoryFromFile() == "" || !index->load())
+    {
+        printError("No index has been built. Run the index command first.");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * printUsage()
+ *
+ * Outputs the usage of the program to std::cerr
+ */
+void CommandLine::printUsage()
+{
+    std::cerr << "Usage: IndexCLI [--type segmented|hash|avl] [--format tsv|json] "
+                 "[--threads N] [--limit N] <command>\n"
+                 "Commands:\n"
+                 "  index <dir>        build the index from a directory of PDFs\n"
+                 "  add <file|dir>     add a PDF or a directory of PDFs to the index\n"
+                 "  remove <file>      remove a PDF from the index\n"
+                 "  refresh [dir]      parse only new or changed PDFs and remove deleted ones\n"
+                 "  search \"<query>\"   search the index with a boolean query\n"
+                 "  serve              answer queries from clients, one per line\n"
+                 "  stats              print the index statistics\n"
+                 "Options of serve: [--socket <path>] [--port N]\n";
+}
+
+/**
+ *
+ * printError(const std::string&)
+ *
+ * Outputs an error message to std::cerr, or a JSON error object to
+ * std::cout if the output format is JSON.
+ *
+ * @param message   - the error message
+ */
+void CommandLine::printError(const std::string& message)
+{
+    if(format == "json")
+        std::cout << "{\"error\":\"" << SearchServer::escape(message) << "\"}" << std::endl;
+    else
+        std::cerr << message << std::endl;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <experimental/filesystem>
+
+#include <Index/indexinterface.h>
+#include <Index/avlindex.h>
+#include <Index/hashindex.h>
+#include <Index/mappedindex.h>
+#include <Index/segmentedindex.h>
+#include <Parser/parser.h>
+#include <QueryProcessor/queryprocessor.h>
+#include <Server/searchserver.h>
+
+/**
+ * The CommandLine class is a non-interactive front end for the PDF search
+ * engine. It drives the Parser, the index, and the QueryProcessor directly
+ * and prints its results as TSV or JSON, so the engine can be scripted and
+ * benchmarked without Qt or ncurses.
+ *
+ * Usage: IndexCLI [options] <command> [argument]
+ *
+ * Commands:
+ *  index <dir>         - build the index from a directory of PDFs
+ *  add <file|dir>      - add a PDF or a directory of PDFs to the index
+ *  remove <file>       - remove a PDF from the index
+ *  refresh [dir]       - parse only the PDFs that are new or have changed, and
+ *                        remove deleted ones (default: the indexed directory)
+ *  search "<query>"    - search the index with a boolean query, which may
+ *                        group words and operators within parentheses
+ *  serve               - load the index once and answer queries from clients
+ *                        over a Unix domain socket or localhost TCP, one per line
+ *  stats               - print the index statistics and most frequent words
+ *
+ * Options:
+ *  --type segmented|hash|avl
+ *                      - the data structure used to build the index (default
+ *                        segmented, which saves new words as a segment file)
+ *  --format tsv|json   - the output format (default tsv)
+ *  --threads N         - the number of threads used to parse PDFs
+ *  --limit N           - the number of documents a search returns (default 15)
+ *  --socket <path>     - the Unix domain socket serve listens on (default index.sock)
+ *  --port N            - the localhost TCP port serve listens on instead of a socket
+ *
+ * By: Oisin Coveney
+ */
+class CommandLine
+{
+    private:
+
+        //Command and its argument
+        std::string command;
+        std::string argument;
+
+        //Options
+        std::string type{"segmented"};
+        std::string format{"tsv"};
+        int limit{NUM_DOCS};
+        std::string socketPath;
+        int port{0};
+
+        //The PDF index
+        IndexInterface* index;
+
+        //Parses the options and the command from the arguments
+        bool parseArguments(int argc, char** argv);
+
+        //Commands
+        int indexDirectory();
+        int addPath();
+        int refreshIndex();
+        int removePath();
+        int search();
+        int serve();
+        int stats();
+
+        //Loads the persistent index, returning false if there is none
+        bool loadIndex();
+
+        //Output
+        void printUsage();
+        void printError(const std::string& message);
+
+    public:
+
+        //Constructor and destructor
+        CommandLine() : command{}, argument{}, socketPath{}, index{nullptr} {}
+        ~CommandLine();
+
+        //Runs the command given by the arguments, returning the exit code
+        int run(int argc, char** argv);
+};
@@ -0,0 +1,7 @@
+#include <CommandLine/commandline.h>
+
+int main(int argc, char** argv)
+{
+    CommandLine commandLine{};
+    return commandLine.run(argc, argv);
+}
@@ -1,112 +1,222 @@
 #include <HashTable/hashtable.h>
 
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+const int HashTable::GROUP_SIZE;
+constexpr double HashTable::DEFAULT_LOAD_FACTOR;
+const int8_t HashTable::EMPTY;
+
 /**
- * insert(string)
  *
- * Inserts the string key into the hash table, returning a reference
- * to the word within the table
+ * matchGroup(const int8_t*, int8_t)
  *
- * @param key   - the string to be used for inserting into the table
- * @return      - a reference to the Word object
+ * Compares the control bytes of a group of slots with a byte, using a
+ * single SSE2 comparison where available.
+ *
+ * @param group - the control bytes of the group
+ * @param byte  - the byte to search for
+ * @return      - a bit mask of the slots whose control byte matches
  */
-Word& HashTable::insert(std::__cxx11::string& key)
+static uint32_t matchGroup(const int8_t* group, int8_t byte)
 {
-    return table[hash(key)].insert(Word(key));
+#if defined(__SSE2__)
+    __m128i bytes = _mm_loadu_si128((const __m128i*) group);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(byte)));
+#else
+    uint32_t mask{};
+    for(int i{}; i < HashTable::GROUP_SIZE; i++)
+    {
+        if(group[i] == byte)
+            mask |= 1u << i;
+    }
+    return mask;
+#endif
 }
 
 /**
- * insert(string, string)
  *
- * Inserts the string into the hash table and insert the document into
- * the reference returned by the insert function
+ * findSlot(const std::string&, uint64_t, bool&)
  *
- * @param key       - the string to be used for inserting into the table
- * @param document  - the document string to add to the Word reference
- * @return          - a reference to the word created with the key
+ * Probes the table for a word. The hash picks the first group of slots,
+ * and the following groups are probed in triangular steps, which visits
+ * every group since the number of groups is a power of two. Words are
+ * never removed, so the first group with an empty slot ends the search.
+ *
+ * @param key   - the word to search for
+ * @param hash  - the hash of the word
+ * @param found - set to true if the word is in the table, false if not
+ * @return      - the slot of the word, or the empty slot it would go into
  */
-Word& HashTable::insert(std::__cxx11::string& key, std::__cxx11::string& document)
+size_t HashTable::findSlot(const std::string& key, uint64_t hash, bool& found) const
 {
-    Word& word = table[hash(key)].insert(Word(key));
-    word.addDoc(document);
-    return word;
+    size_t groupMask = slots.size() / GROUP_SIZE - 1;
+    size_t group = (hash >> 7) & groupMask;
+    int8_t tag = hash & 0x7F;
+
+    for(size_t step{1}; ; step++)
+    {
+        const int8_t* groupControl = control.data() + group * GROUP_SIZE;
+
+        //Only compare the words whose control byte matches
+        for(uint32_t matches = matchGroup(groupControl, tag); matches != 0; matches &= matches - 1)
+        {
+            size_t slot = group * GROUP_SIZE + __builtin_ctz(matches);
+            uint32_t word = slots[slot];
+            if(hashes[word] == hash && words[word].getWord() == key)
+            {
+                found = true;
+                return slot;
+            }
+        }
+
+        uint32_t empties = matchGroup(groupControl, EMPTY);
+        if(empties != 0)
+        {
+            found = false;
+            return group * GROUP_SIZE + __builtin_ctz(empties);
+        }
+
+        group = (group + step) & groupMask;
+    }
 }
 
 /**
- * insert(Word)
  *
- * Inserts the word object into the tree, returning a reference to the Word
- * object after it is inserted into the tree
+ * rehash(size_t)
  *
- * @param word
- * @return
+ * Resizes the table and puts every word into its slot within the new table.
+ * The hashes of the words are stored, so the words aren't hashed again.
+ *
+ * @param capacity  - the new number of slots, a power of two
  */
-Word& HashTable::insert(Word& word)
+void HashTable::rehash(size_t capacity)
 {
-    return table[hash(word.getWord())].insert(word);
+    control.assign(capacity, EMPTY);
+    slots.assign(capacity, 0);
+
+    size_t groupMask = capacity / GROUP_SIZE - 1;
+    for(uint32_t word{}; word < hashes.size(); word++)
+    {
+        size_t group = (hashes[word] >> 7) & groupMask;
+        uint32_t empties = matchGroup(control.data() + group * GROUP_SIZE, EMPTY);
+        for(size_t step{1}; empties == 0; step++)
+        {
+            group = (group + step) & groupMask;
+            empties = matchGroup(control.data() + group * GROUP_SIZE, EMPTY);
+        }
+
+        size_t slot = group * GROUP_SIZE + __builtin_ctz(empties);
+        control[slot] = hashes[word] & 0x7F;
+        slots[slot] = word;
+    }
 }
 
 /**
- * hash(const string) const
- *
- * Hashes a const string reference and returns an integer based on the string
+ * insert(string)
  *
- * With help from: http://www.cse.yorku.ca/~oz/hash.html
+ * Inserts the string key into the hash table, returning a reference
+ * to the word within the table. A Word is only created if the key is
+ * not already in the table.
  *
- * @param key   - the string key to find the place within the hash table
- * @return      - an integer containing the index where the key should go
+ * @param key   - the string to be used for inserting into the table
+ * @return      - a reference to the Word object
  */
-int HashTable::hash(const std::__cxx11::string& key) const
+Word& HashTable::insert(const std::string& key)
 {
-    unsigned long hash = 5381;
-    for(int i = 0; i < (int) key.length(); i++)
+    uint64_t h = hash(key);
+    bool found;
+    size_t slot = findSlot(key, h, found);
+    if(found)
+        return words[slots[slot]];
+
+    if(words.size() + 1 > maxLoadFactor * slots.size())
     {
-        hash = ((hash << 5) + hash) + key[i];
+        rehash(slots.size() * 2);
+        slot = findSlot(key, h, found);
     }
 
-    return hash % LENGTH;
+    control[slot] = h & 0x7F;
+    slots[slot] = words.size();
+    words.emplace_back(key);
+    hashes.push_back(h);
+    return words.back();
 }
 
 /**
+ * insert(string, uint32_t)
  *
- * hash(string)
+ * Inserts the string into the hash table and insert the document into
+ * the reference returned by the insert function
  *
- * Hashes a string reference and returns an integer based on the string
+ * @param key       - the string to be used for inserting into the table
+ * @param document  - the document ID to add to the Word reference
+ * @return          - a reference to the word created with the key
+ */
+Word& HashTable::insert(const std::string& key, uint32_t document)
+{
+    Word& word = insert(key);
+    word.addDoc(document);
+    return word;
+}
+
+/**
+ * insert(Word)
  *
- * With help from: http://www.cse.yorku.ca/~oz/hash.html
+ * Inserts a copy of the word object into the table, returning a reference
+ * to the Word object within the table. If the word is already in the
+ * table, the existing Word is returned.
  *
- * @param key   - the string key to find the place within the hash table
- * @return      - an integer containing the index where the key should go
+ * @param word  - the Word to insert
+ * @return      - a reference to the Word within the table
  */
-int HashTable::hash(std::__cxx11::string& key)
+Word& HashTable::insert(const Word& word)
 {
-    unsigned long hash = 5381;
-    for(int i = 0; i < (int) key.length(); i++)
+    const std::string& key = word.getWord();
+    uint64_t h = hash(key);
+    bool found;
+    size_t slot = findSlot(key, h, found);
+    if(found)
+        return words[slots[slot]];
+
+    if(words.size() + 1 > maxLoadFactor * slots.size())
     {
-        hash = ((hash << 5) + hash) + key[i];
+        rehash(slots.size() * 2);
+        slot = findSlot(key, h, found);
     }
 
-    return hash % LENGTH;
+    control[slot] = h & 0x7F;
+    slots[slot] = words.size();
+    words.push_back(word);
+    hashes.push_back(h);
+    return words.back();
 }
 
 /**
- * hash(rvalue string)
+ * hash(const string)
  *
- * Hashes a rvalue string and returns an integer based on the string
+ * Hashes a string with 64-bit FNV-1a, followed by a final mix so the low
+ * bits, which pick the slot, depend on every character.
  *
- * With help from: http://www.cse.yorku.ca/~oz/hash.html
- *
- * @param key   - an rvalue string key to find the place within the hash table
- * @return      - an integer containing the index where the key should go
+ * @param key   - the string to hash
+ * @return      - the hash of the string
  */
-int HashTable::hash(std::__cxx11::string&& key)
+uint64_t HashTable::hash(const std::string& key)
 {
-    unsigned long hash = 5381;
-    for(int i = 0; i < (int) key.length(); i++)
+    uint64_t hash = 14695981039346656037ull;
+    for(unsigned char c : key)
     {
-        hash = ((hash << 5) + hash) + key[i];
+        hash ^= c;
+        hash *= 1099511628211ull;
     }
 
-    return hash % LENGTH;
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
 }
 
 /**
@@ -115,8 +225,10 @@ int HashTable::hash(std::__cxx11::string&& key)
  */
 void HashTable::clear()
 {
-    for(int i{}; i < LENGTH; i++)
-        table[i].clear();
+    words.clear();
+    hashes.clear();
+    control.assign(GROUP_SIZE, EMPTY);
+    slots.assign(GROUP_SIZE, 0);
 }
 
 /**
@@ -124,19 +236,38 @@ void HashTable::clear()
  */
 HashTable::~HashTable() {}
 
+/**
+ *
+ * reserve(size_t)
+ *
+ * Grows the table so the number of words given fits without the table
+ * growing again.
+ *
+ * @param numWords  - the number of words to make room for
+ */
+void HashTable::reserve(size_t numWords)
+{
+    size_t capacity = slots.size();
+    while(numWords > maxLoadFactor * capacity)
+        capacity *= 2;
+
+    if(capacity != slots.size())
+        rehash(capacity);
+}
+
 /**
  * operator[] overload
  *
- * @param index - the index to find the element within the table
- * @return      - the AVL tree reference at the index of the hash table
+ * @param index - the number of the word, in order of insertion
+ * @return      - the Word reference at the index
  * @exception   - out_of_range if the index is not within bounds
  */
-AvlTree<Word>& HashTable::operator[](int index)
+Word& HashTable::operator[](int index)
 {
-    if(index < 0 || index >= LENGTH)
+    if(index < 0 || index >= (int) words.size())
         throw std::out_of_range("The index is outside the bounds of the table.");
 
-    return table[index];
+    return words[index];
 }
 
 /**
@@ -148,9 +279,9 @@ AvlTree<Word>& HashTable::operator[](int index)
  */
 std::ostream& operator<<(std::ostream& o, const HashTable& tab)
 {
-    for(int i{}; i < LENGTH; i++)
+    for(const Word& word : tab.words)
     {
-        o << tab.table[i];
+        o << word;
     }
     return o;
 }
@@ -160,20 +291,57 @@ std::ostream& operator<<(std::ostream& o, const HashTable& tab)
  *
  * Returns the a Word reference from the specified key
  *
- * @param key   - the string to search the tree with
- * @return      - a reference to the Word object within the tree
+ * @param key   - the string to search the table with
+ * @return      - a reference to the Word object within the table
  * @exception   - out_of_range if the reference does not exist
  */
-Word& HashTable::getWord(const std::__cxx11::string& key)
+Word& HashTable::getWord(const std::string& key)
 {
-    return table[hash(key)].find(key);
+    bool found;
+    size_t slot = findSlot(key, hash(key), found);
+    if(!found)
+        throw std::out_of_range("The word is not within the table.");
+
+    return words[slots[slot]];
 }
 
 /**
  * getSize()
- * @return the length of the hash table
+ * @return the number of words within the hash table
+ */
+int HashTable::getSize() const
+{
+    return words.size();
+}
+
+/**
+ * getCapacity()
+ * @return the number of slots within the hash table
+ */
+int HashTable::getCapacity() const
+{
+    return slots.size();
+}
+
+/**
+ * getMaxLoadFactor()
+ * @return the maximum fraction of slots that are full before the table grows
+ */
+double HashTable::getMaxLoadFactor() const
+{
+    return maxLoadFactor;
+}
+
+/**
+ * setMaxLoadFactor(double)
+ *
+ * Sets the maximum load factor, between 0.25 and 15/16 so every group
+ * keeps an empty slot on average. The table grows if it is now too full.
+ *
+ * @param value - the maximum fraction of slots that are full
  */
-int HashTable::getSize()
+void HashTable::setMaxLoadFactor(double value)
 {
-    return LENGTH;
+    maxLoadFactor = std::min(std::max(value, 0.25), 0.9375);
+    reserve(words.size());
 }
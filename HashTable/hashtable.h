@@ -2,46 +2,76 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <iostream>
-#include <array>
+#include <cstdint>
 
-#include <AVLTree/avltree.h>
 #include <Word/word.h>
 
 
-#define LENGTH 10000
-
-
 /**
  * The HashTable class contains a hash table implementation made specifically
- * for the Word class, serving as an effective hash table structure for the
- * PDF search engine. The hash table contains an array with a globally
- * defined LENGTH, with all elements containing AVL trees.
+ * for the Word class, serving as the term dictionary of the PDF search
+ * engine. The table uses open addressing in the style of SwissTable: every
+ * slot has a control byte holding 7 bits of the word's hash, and the
+ * control bytes are probed a group of GROUP_SIZE slots at a time, with a
+ * single SSE2 comparison per group. Only slots whose control byte matches
+ * are compared with the word itself.
+ *
+ * The table doubles in size once it is filled past its maximum load
+ * factor. The Word objects are stored separately from the slots, in order
+ * of insertion, so references to them stay valid when the table grows.
  *
  * By: Oisin Coveney
  */
 class HashTable
 {
-        friend class AvlTree<Word>;
     public:
 
-        //Array/vector of linked lists for chaining
-        std::array<AvlTree<Word>, LENGTH> table;
+        //Number of slots probed at once
+        static const int GROUP_SIZE = 16;
+
+        //Default maximum fraction of the slots that are full
+        static constexpr double DEFAULT_LOAD_FACTOR = 0.875;
+
+    private:
+
+        //Control byte of each slot: EMPTY, or the low 7 bits of the hash
+        static const int8_t EMPTY = -128;
+        std::vector<int8_t> control;
+
+        //Number of the word in each slot
+        std::vector<uint32_t> slots;
+
+        //Words and their hashes, in order of insertion
+        std::deque<Word> words;
+        std::vector<uint64_t> hashes;
+
+        double maxLoadFactor;
+
+        //Find the slot of a word, or the empty slot it would go into
+        size_t findSlot(const std::string& key, uint64_t hash, bool& found) const;
+
+        //Resize the table to the given number of slots
+        void rehash(size_t capacity);
 
     public:
 
         //Constructor
-        HashTable() : table{} {}
+        HashTable(double maxLoadFactor = DEFAULT_LOAD_FACTOR)
+            : control(GROUP_SIZE, EMPTY), slots(GROUP_SIZE), words{}, hashes{},
+              maxLoadFactor{DEFAULT_LOAD_FACTOR}
+        {
+            setMaxLoadFactor(maxLoadFactor);
+        }
 
         //Insertion
-        Word& insert(std::string& key);
-        Word& insert(std::string& key, std::string& document);
-        Word& insert(Word& word);
+        Word& insert(const std::string& key);
+        Word& insert(const std::string& key, uint32_t document);
+        Word& insert(const Word& word);
 
         //Hash function
-        int hash(const std::__cxx11::string& key) const;
-        int hash(std::__cxx11::string& key);
-        int hash(std::__cxx11::string&& key);
+        static uint64_t hash(const std::string& key);
 
         //Clear
         void clear();
@@ -49,14 +79,17 @@ class HashTable
         //Destructor
         ~HashTable();
 
+        //Make room for a number of words without growing
+        void reserve(size_t numWords);
+
         //General functions
-        AvlTree<Word>& operator[](int index);
+        Word& operator[](int index);
         friend std::ostream& operator<<(std::ostream& o, const HashTable& tab);
-        Word& getWord(const std::__cxx11::string& key);
-        int getSize();
+        Word& getWord(const std::string& key);
+        int getSize() const;
+        int getCapacity() const;
 
+        //Load factor
+        double getMaxLoadFactor() const;
+        void setMaxLoadFactor(double value);
 };
-
-
-
-
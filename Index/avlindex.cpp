@@ -1,24 +1,5 @@
 #include <Index/avlindex.h>
 
-/**
- * recalcRankingHelper(Node<Word>)
- *
- * A helper function for recalculating the ranking of each element within the
- * tree. The function is recursively called until it hits the nullptr children
- * of each node.
- *
- * @param node  - the head of the tree to calculate frankings from
- */
-void AVLIndex::recalcRankingHelper(Node<Word>*& node)
-{
-    if(node != nullptr)
-    {
-        node->data.calculateRanking();
-        recalcRankingHelper(node->left);
-        recalcRankingHelper(node->right);
-    }
-}
-
 /**
  *
  * insert(std::string)
@@ -39,21 +20,21 @@ Word& AVLIndex::insert(std::string& word)
 
 /**
  *
- * insert(std::string, std::string)
+ * insert(std::string, uint32_t)
  *
- * Adds the document string to the Word object containing the word string
+ * Adds the document ID to the Word object containing the word string
  * given by the parameter. If the word does not exist within the tree,
  * it is added to the tree.
  *
  * @param word      - the word to add to the tree and add a document to
- * @param document  - the document to add to the specified Word object
+ * @param document  - the ID of the document to add to the Word object
  */
-void AVLIndex::insert(std::string& word, std::string& document)
+void AVLIndex::insert(std::string& word, uint32_t document)
 {
     Word& ref = tree.insert(Word(word));
-    addToFrequencyList(ref);
     isEmpty = false;
     ref.addDoc(document);
+    addToFrequencyList(ref);
 }
 
 /**
@@ -102,12 +83,8 @@ Word& AVLIndex::get(const std::string& word)
  */
 std::string AVLIndex::getDirectoryFromFile()
 {
-    std::ifstream is{};
-    is.open(getIndexFile());
-    std::string directory;
-    is >> directory;
-    is.close();
-    return directory;
+    IndexFile file;
+    return file.open(getIndexFile()) ? file.getDirectory() : "";
 }
 
 /**
@@ -124,96 +101,84 @@ std::__cxx11::string AVLIndex::getDataType()
  *
  * load()
  *
- * Loads the PDF index from the index file, and loads the table of documents
- * and the total number of words found.
+ * Loads the PDF index from the index file, along with the table of
+ * documents, the total number of words found, and the most frequent words.
+ * The words of every segment the file lists are loaded as well.
  *
- * @return - false if the index file is invalid, true otherwise
+ * @return - false if the index file or a segment is invalid, true otherwise
  */
 bool AVLIndex::load()
 {
-    isEmpty = false;
-    std::ifstream is{};
-    is.open(getIndexFile());
+    IndexFile file;
+    if(!file.open(getIndexFile()))
+        return false;
 
-    std::string type;
-    is >> indexDirectory >> type >> Parser::numFiles
-            >> Parser::numPages >> Parser::numWords;
+    indexDirectory = file.getDirectory();
+    markAllChanged();
+    Parser::numFiles = file.getNumFiles();
+    Parser::numPages = file.getNumPages();
+    Parser::numWords = file.getNumWords();
 
-    //If the index file is in AVL tree form, parsing is much faster
-    if(type == "AVL")
-    {
-        std::getline(is, type);
-        std::getline(is, type);
-        tree.head = loadTree(tree.head, is);
-    }
-    //Otherwise, just brute force and add all documents
-    else if(type == "HASH")
+    //The terms are sorted, so the tree can be built already balanced
+    tree.clear();
+    tree.head = loadTree(file, 0, file.getNumTerms() - 1);
+    tree.numElements = file.getNumTerms();
+    isEmpty = false;
+
+    //Add the words of the segments, merging the words already in the tree
+    for(const std::string& segment : file.getSegments())
     {
-        while(is >> type)
+        IndexFile part;
+        if(!part.open(segment))
+            return false;
+
+        for(int i{}; i < part.getNumTerms(); i++)
         {
-            if(!(type == "$$$" || type == "end---------------------------------"
-                 || type == "start-------------------------------"))
-            {
-                insert(Word(type, is));
-            }
+            Word word{part.getWord(i)};
+            int size = tree.numElements;
+            Word& inserted = tree.insert(word);
+            if(tree.numElements == size)
+                inserted.merge(word);
         }
     }
 
-    is.close();
-
-    //Get table of document-word count
-    std::ifstream ifs;
-    ifs.open(getWordCount());
+    //Get the document table, so document IDs match the postings
+    file.readDocuments(Parser::documents);
 
-    int numWords;
-    ifs >> numWords;
-
-    int total;
-    std::string doc;
-    for(int i{}; i < numWords; i++)
+    //Get most frequent words
+    frequentWords.clear();
+    for(const std::string& word : file.getFrequentWords())
     {
-        ifs >> doc >> total;
-        Parser::totalWordsInDoc[doc] = total;
+        frequentWords.update(tree.find(Word(word)));
     }
-    ifs.close();
-
-    //Get most frequent words
-    loadFrequencyList(tree.head);
     return true;
 }
 
 
 /**
  *
- * loadTree(Node<Word>* node, std::istream&)
+ * loadTree(IndexFile&, int, int)
  *
- * Helper function to load an AVL tree from an istream to the given node.
- * When the function is complete, the whole AVL tree for the istream should
- * be added.
+ * Helper function to build a balanced AVL tree from a range of the sorted
+ * terms within the index file. The middle term becomes the head of the
+ * tree, and the terms on either side become its subtrees.
  *
- * @param node  - the node to add to the tree
- * @param is    - the stream to take data from
+ * @param file  - the index file to take the terms from
+ * @param low   - the first term of the range
+ * @param high  - the last term of the range
  * @return      - the head node of the new tree
  */
-Node<Word>* AVLIndex::loadTree(Node<Word>*& node, std::istream& is)
+Node<Word>* AVLIndex::loadTree(IndexFile& file, int low, int high)
 {
-    std::string buf;
-    //Checks if the end of the tree has been found
-    while(is >> buf)
-    {
-        //Null pointer delimiter
-        if(buf == "$$$")
-            return nullptr;
-        else
-        {
-            node = new Node<Word>(Word(buf, is));
-            node->left = loadTree(node->left, is);
-            node->right = loadTree(node->right, is);
-            node->height = std::max(tree.getHeight(node->left),
-                                    tree.getHeight(node->right)) + 1;
-            return node;
-        }
-    }
+    if(low > high)
+        return nullptr;
+
+    int mid = low + (high - low) / 2;
+    Node<Word>* node = new Node<Word>(file.getWord(mid));
+    node->left = loadTree(file, low, mid - 1);
+    node->right = loadTree(file, mid + 1, high);
+    node->height = std::max(tree.getHeight(node->left),
+                            tree.getHeight(node->right)) + 1;
     return node;
 }
 
@@ -221,50 +186,15 @@ Node<Word>* AVLIndex::loadTree(Node<Word>*& node, std::istream& is)
  *
  * addToFrequencyList(Word&)
  *
- * Adds the Word object to the list of frequent words if it happens to be
- * in the index frequently. Otherwise, nothing happens.
+ * Updates the list of frequent words after a word has been inserted or its
+ * frequency has grown. Words that are not frequent enough are rejected
+ * without searching the list.
  *
  * @param word  - the Word object to check against and add to the list
  */
 void AVLIndex::addToFrequencyList(Word& word)
 {
-    if(std::find(frequentWords.begin(), frequentWords.end(), &word) == frequentWords.end())
-        frequentWords.push_back(&word);
-
-    std::sort(frequentWords.begin(), frequentWords.end(), [](Word*& lhs, Word*& rhs)
-    {
-        return lhs->getTotalFrequency() > rhs->getTotalFrequency();
-    });
-    if(frequentWords.size() >= 50)
-    {
-        while(frequentWords.size() != 50)
-        {
-            frequentWords.pop_back();
-        }
-    }
-}
-
-/**
- *
- * loadFrequencyList(Node<Word>*)
- *
- * Recursively moves through each node within the given Node<Word> (presumably
- * an AVL tree) to find the most frequent words within the index.
- *
- * @param head  - the head of the tree within the hash table
- */
-void AVLIndex::loadFrequencyList(Node<Word>*& head)
-{
-    if(head == nullptr)
-        return;
-    else
-    {
-        addToFrequencyList(head->data);
-        loadFrequencyList(head->left);
-        loadFrequencyList(head->right);
-    }
-    return;
-
+    frequentWords.update(word);
 }
 
 /**
@@ -274,21 +204,10 @@ void AVLIndex::loadFrequencyList(Node<Word>*& head)
  */
 void AVLIndex::printFrequencyList()
 {
-    for(Word* w : frequentWords)
+    for(Word* w : getFrequentWords())
         std::cout << w->getWord() << "\t" << w->getTotalFrequency() << " times" << std::endl;
 }
 
-/**
- * recalculateRanking()
- *
- * Recalculates the ranking of all elements within AVL tree using
- * the recalcRankingHelper function
- */
-void AVLIndex::recalculateRanking()
-{
-    recalcRankingHelper(tree.head);
-}
-
 /**
  *
  * clear()
@@ -299,35 +218,53 @@ void AVLIndex::clear()
 {
     isEmpty = true;
     tree.clear();
+    frequentWords.clear();
+    markAllChanged();
 }
 
 /**
  *
  * printToFile()
  *
- * Prints the PDF index to the index file, and prints the table of
- * document-total word combinations to the wordCount file.
+ * Prints the PDF index and the table of document-total word combinations
+ * to the index file.
  *
  */
 void AVLIndex::printToFile()
 {
-    //output the AVL tree to index file
-    std::ofstream o;
-    o.open(getIndexFile());
-    o << indexDirectory << "\t";
-    o << "AVL" << "\t" << Parser::getNumFiles()  << "\t";
-    o << Parser::getNumPages() << "\t" << Parser::getNumWords() << std::endl;
-    o << tree;
-    o.close();
+    IndexFile::write(getIndexFile(), *this);
+}
 
-    //output the document-word count table
-    o.open(getWordCount());
-    o << Parser::totalWordsInDoc.size() << std::endl;
-    for(auto it = Parser::totalWordsInDoc.begin(); it != Parser::totalWordsInDoc.end(); ++it)
+/**
+ *
+ * getWords(std::vector<Word*>&)
+ *
+ * Adds a pointer to every word within the tree to the vector.
+ *
+ * @param words - the vector to add the words to
+ */
+void AVLIndex::getWords(std::vector<Word*>& words)
+{
+    getWordsHelper(tree.head, words);
+}
+
+/**
+ *
+ * getWordsHelper(Node<Word>*, std::vector<Word*>&)
+ *
+ * Recursively adds a pointer to every word within the tree to the vector.
+ *
+ * @param node  - the head of the tree
+ * @param words - the vector to add the words to
+ */
+void AVLIndex::getWordsHelper(Node<Word>* node, std::vector<Word*>& words)
+{
+    if(node != nullptr)
     {
-        o << it->first << "\t" << it->second << std::endl;
+        words.push_back(&node->data);
+        getWordsHelper(node->left, words);
+        getWordsHelper(node->right, words);
     }
-    o.close();
 }
 
 /**
@@ -2,6 +2,7 @@
 
 #include <AVLTree/avltree.h>
 #include <Index/indexinterface.h>
+#include <Index/indexfile.h>
 
 
 /**
@@ -19,8 +20,8 @@ class AVLIndex : public IndexInterface
         AvlTree<Word> tree;
         bool isEmpty;
 
-        //Helper for recalculating the ranking of all elements
-        void recalcRankingHelper(Node<Word>*& node);
+        //Helper for collecting every word in the tree
+        void getWordsHelper(Node<Word>* node, std::vector<Word*>& words);
     public:
 
         //Constructor
@@ -28,7 +29,7 @@ class AVLIndex : public IndexInterface
 
         //Insertion
         Word& insert(std::string& word) override;
-        void insert(std::__cxx11::string& word, std::__cxx11::string& document) override;
+        void insert(std::__cxx11::string& word, uint32_t document) override;
         void insert(Word word) override;
 
         //Check if empty
@@ -37,6 +38,9 @@ class AVLIndex : public IndexInterface
         //Return element
         Word& get(const std::__cxx11::string& word) override;
 
+        //Collect every word in the tree
+        void getWords(std::vector<Word*>& words) override;
+
         //Clear index
         void clear() override;
 
@@ -47,20 +51,16 @@ class AVLIndex : public IndexInterface
         //Destructor
         ~AVLIndex();
 
-        //Load tree from istream
-        Node<Word>* loadTree(Node<Word>*& node, std::istream& is);
+        //Build a balanced tree from the sorted terms of the index file
+        Node<Word>* loadTree(IndexFile& file, int low, int high);
 
         //operator << overload
         friend std::ostream& operator<<(std::ostream& o, const AVLIndex& index);
 
         //Frequency List functions
         void addToFrequencyList(Word& word) override;
-        void loadFrequencyList(Node<Word>*& head);
         void printFrequencyList() override;
 
-        //Recalculate ranking
-        void recalculateRanking() override;
-
         //get directory from file
         std::string getDirectoryFromFile() override;
 
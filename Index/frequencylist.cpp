@@ -0,0 +1,222 @@
+#include <Index/frequencylist.h>
+#include <Word/word.h>
+
+#include <algorithm>
+
+/**
+ * lessFrequent(const Word*, const Word*)
+ *
+ * Orders words by frequency, and words of the same frequency in reverse
+ * alphabetical order, so the words kept in a full list don't depend on
+ * the order the words were added in.
+ *
+ * @param lhs   - a word
+ * @param rhs   - a word
+ * @return      - true if lhs ranks below rhs in the list
+ */
+bool FrequencyList::lessFrequent(const Word* lhs, const Word* rhs)
+{
+    return lhs->getTotalFrequency() < rhs->getTotalFrequency()
+            || (lhs->getTotalFrequency() == rhs->getTotalFrequency()
+                && lhs->getWord() > rhs->getWord());
+}
+
+/**
+ * lessFrequent(int, int)
+ *
+ * @param lhs   - a position in the heap
+ * @param rhs   - a position in the heap
+ * @return      - true if the word at lhs ranks below the word at rhs
+ */
+bool FrequencyList::lessFrequent(int lhs, int rhs) const
+{
+    return lessFrequent(heap[lhs], heap[rhs]);
+}
+
+/**
+ * swap(int, int)
+ *
+ * Swaps two words within the heap, along with their positions.
+ *
+ * @param lhs   - a position in the heap
+ * @param rhs   - a position in the heap
+ */
+void FrequencyList::swap(int lhs, int rhs)
+{
+    std::swap(heap[lhs], heap[rhs]);
+    positions[heap[lhs]] = lhs;
+    positions[heap[rhs]] = rhs;
+}
+
+/**
+ * siftUp(int)
+ *
+ * Moves a word towards the top of the heap until its parent is not more
+ * frequent than it.
+ *
+ * @param position  - the position of the word in the heap
+ */
+void FrequencyList::siftUp(int position)
+{
+    while(position > 0 && lessFrequent(position, (position - 1) / 2))
+    {
+        swap(position, (position - 1) / 2);
+        position = (position - 1) / 2;
+    }
+}
+
+/**
+ * siftDown(int)
+ *
+ * Moves a word towards the bottom of the heap until neither of its
+ * children are less frequent than it.
+ *
+ * @param position  - the position of the word in the heap
+ */
+void FrequencyList::siftDown(int position)
+{
+    int size = heap.size();
+    while(true)
+    {
+        int smallest = position;
+        int left = 2 * position + 1;
+        int right = left + 1;
+
+        if(left < size && lessFrequent(left, smallest))
+            smallest = left;
+        if(right < size && lessFrequent(right, smallest))
+            smallest = right;
+        if(smallest == position)
+            return;
+
+        swap(position, smallest);
+        position = smallest;
+    }
+}
+
+/**
+ *
+ * update(Word&)
+ *
+ * Updates the list after the frequency of a word has grown, or after a word
+ * has been added to the index. A word already in the list moves down the
+ * heap, and a word not in the list replaces the least frequent word if it
+ * is now more frequent than it.
+ *
+ * @param word  - the word whose frequency has grown
+ */
+void FrequencyList::update(Word& word)
+{
+    //Words in the list are at least as frequent as the top of the heap
+    if((int) heap.size() == capacity
+            && word.getTotalFrequency() < heap[0]->getTotalFrequency())
+        return;
+
+    auto it = positions.find(&word);
+    if(it != positions.end())
+    {
+        siftDown(it->second);
+    }
+    else if((int) heap.size() < capacity)
+    {
+        positions[&word] = heap.size();
+        heap.push_back(&word);
+        siftUp(heap.size() - 1);
+    }
+    else if(lessFrequent(heap[0], &word))
+    {
+        positions.erase(heap[0]);
+        positions[&word] = 0;
+        heap[0] = &word;
+        siftDown(0);
+    }
+}
+
+/**
+ *
+ * update(const std::vector<Word*>&)
+ *
+ * Updates the list after the frequencies of many words have grown without
+ * the list being told, such as a batch of documents merged into the index
+ * by several threads. The words already in the list are moved down the
+ * heap from the bottom up, which restores the heap whichever of them have
+ * grown, and then the other words are offered to the list one at a time.
+ * A word may appear more than once.
+ *
+ * @param words - the words whose frequencies have grown
+ */
+void FrequencyList::update(const std::vector<Word*>& words)
+{
+    std::vector<int> grown;
+    for(Word* w : words)
+    {
+        auto it = positions.find(w);
+        if(it != positions.end())
+            grown.push_back(it->second);
+    }
+
+    std::sort(grown.begin(), grown.end());
+    grown.erase(std::unique(grown.begin(), grown.end()), grown.end());
+    for(auto it = grown.rbegin(); it != grown.rend(); ++it)
+        siftDown(*it);
+
+    for(Word* w : words)
+        update(*w);
+}
+
+/**
+ *
+ * rebuild(const std::vector<Word*>&)
+ *
+ * Empties the list and fills it again from the given words, skipping words
+ * that are no longer in any document.
+ *
+ * @param words - every word of the index
+ */
+void FrequencyList::rebuild(const std::vector<Word*>& words)
+{
+    clear();
+    for(Word* w : words)
+    {
+        if(w->getTotalFrequency() > 0)
+            update(*w);
+    }
+}
+
+/**
+ *
+ * getWords()
+ *
+ * @return  - the words in the list, most frequent first, with words of the
+ *            same frequency in alphabetical order
+ */
+std::vector<Word*> FrequencyList::getWords() const
+{
+    std::vector<Word*> words{heap};
+    std::sort(words.begin(), words.end(), [](Word* lhs, Word* rhs)
+    {
+        if(lhs->getTotalFrequency() != rhs->getTotalFrequency())
+            return lhs->getTotalFrequency() > rhs->getTotalFrequency();
+        return lhs->getWord() < rhs->getWord();
+    });
+    return words;
+}
+
+/**
+ * size()
+ * @return  - the number of words in the list
+ */
+int FrequencyList::size() const
+{
+    return heap.size();
+}
+
+/**
+ * clear()
+ * Removes every word from the list
+ */
+void FrequencyList::clear()
+{
+    heap.clear();
+    positions.clear();
+}
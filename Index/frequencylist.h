@@ -0,0 +1,65 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+class Word;
+
+/**
+ * The FrequencyList class keeps track of the most frequent words of an
+ * index as words are inserted. The words are kept in a min-heap ordered by
+ * their total frequency, along with the position of each word within the
+ * heap, so a word whose frequency has grown is moved in O(log K) time for
+ * a list of K words. A word less frequent than the least frequent word in
+ * a full list is rejected in constant time, without any lookup. Words of
+ * the same frequency are ranked alphabetically, so the list is the same
+ * however the index was built. Since the heap assumes frequencies only
+ * grow, it is rebuilt from every word once documents have been removed
+ * from the index.
+ *
+ * The list holds pointers to the words within the index, so the words must
+ * not move while they are in the list.
+ *
+ * By: Oisin Coveney
+ */
+class FrequencyList
+{
+    private:
+
+        //Maximum number of words in the list
+        int capacity;
+
+        //Min-heap of the words, and the position of each word in the heap
+        std::vector<Word*> heap;
+        std::unordered_map<const Word*, int> positions;
+
+        //Heap functions
+        static bool lessFrequent(const Word* lhs, const Word* rhs);
+        bool lessFrequent(int lhs, int rhs) const;
+        void swap(int lhs, int rhs);
+        void siftUp(int position);
+        void siftDown(int position);
+
+    public:
+
+        //Constructor
+        FrequencyList(int capacity) : capacity{capacity}, heap{}, positions{} {}
+
+        //Update the list after the frequency of a word has grown
+        void update(Word& word);
+
+        //Update the list after the frequencies of many words have grown at once
+        void update(const std::vector<Word*>& words);
+
+        //Rebuild the list from every word, after frequencies have shrunk
+        void rebuild(const std::vector<Word*>& words);
+
+        //Get the words, most frequent first
+        std::vector<Word*> getWords() const;
+
+        //Number of words in the list
+        int size() const;
+
+        //Clear the list
+        void clear();
+};
@@ -15,25 +15,6 @@ bool HashIndex::empty()
     return isEmpty;
 }
 
-/**
- * recalcRankingHelper(Node<Word>)
- *
- * A helper function for recalculating the ranking of each element within the
- * trees of the hash table. The function is recursively called until it
- * hits the nullptr children of each node.
- *
- * @param node  - the head of the tree to calculate frankings from
- */
-void HashIndex::recalcRankingHelper(Node<Word>*& node)
-{
-    if(node != nullptr)
-    {
-        node->data.calculateRanking();
-        recalcRankingHelper(node->left);
-        recalcRankingHelper(node->right);
-    }
-}
-
 /**
  *
  * insert(std::string)
@@ -55,22 +36,22 @@ Word& HashIndex::insert(std::__cxx11::string& word)
 
 /**
  *
- * insert(std::string, std::string)
+ * insert(std::string, uint32_t)
  *
- * Adds the document string to the Word object containing the word string
+ * Adds the document ID to the Word object containing the word string
  * given by the parameter. If the word does not exist within the table,
  * it is added to the table.
  *
  * @param word      - the word to add to the table and add a document to
- * @param document  - the document to add to the specified Word object
+ * @param document  - the ID of the document to add to the Word object
  */
-void HashIndex::insert(std::__cxx11::string& word, std::__cxx11::string& document)
+void HashIndex::insert(std::__cxx11::string& word, uint32_t document)
 {
     isEmpty = false;
 
     Word& ref = table.insert(word);
-    addToFrequencyList(ref);
     ref.addDoc(document);
+    addToFrequencyList(ref);
 
 }
 
@@ -115,12 +96,8 @@ Word& HashIndex::get(const std::__cxx11::string& word)
  */
 std::string HashIndex::getDirectoryFromFile()
 {
-    std::ifstream is{};
-    is.open(getIndexFile());
-    std::string directory;
-    is >> directory;
-    is.close();
-    return directory;
+    IndexFile file;
+    return file.open(getIndexFile()) ? file.getDirectory() : "";
 }
 
 /**
@@ -138,72 +115,69 @@ std::__cxx11::string HashIndex::getDataType()
  *
  * load()
  *
- * Loads the PDF index from the index file, and loads the table of documents
- * and the total number of words found.
+ * Loads the PDF index from the index file, along with the table of
+ * documents, the total number of words found, and the most frequent words.
+ * The words of every segment the file lists are loaded as well.
  *
- * @return - false if the index file is invalid, true otherwise
+ * @return - false if the index file or a segment is invalid, true otherwise
  */
 bool HashIndex::load()
 {
-    std::ifstream is{};
-    is.open(getIndexFile());
-
+    IndexFile file;
+    if(!file.open(getIndexFile()))
+        return false;
 
-    std::string type;
-    is >> indexDirectory >> type >> Parser::numFiles >> Parser::numPages >> Parser::numWords;
+    indexDirectory = file.getDirectory();
+    markAllChanged();
+    Parser::numFiles = file.getNumFiles();
+    Parser::numPages = file.getNumPages();
+    Parser::numWords = file.getNumWords();
 
-    //If the index file has the same structure, parsing is faster
-    if(type == "HASH")
-    {
-        int i{};
-        while(is >> type && i < LENGTH)
-        {
-            table[i].head = loadTree(table[i].head, is);
-            is >> type;
-            i++;
-        }
-    }
-    //Otherwise, brute force the parsing and just add all words linearly
-    else if(type == "AVL")
+    //Add every word to the table, from the index file and its segments
+    table.reserve(file.getNumTerms());
+    loadWords(file);
+    for(const std::string& segment : file.getSegments())
     {
-        while(is >> type)
-        {
-            if(!(type == "$$$" || type == "end---------------------------------"
-                 || type == "start-------------------------------"))
-            {
-                insert(Word(type, is));
-            }
-        }
+        IndexFile part;
+        if(!part.open(segment))
+            return false;
+        loadWords(part);
     }
-    else
-    {
-        is.close();
-        return false;
-    }
-
     isEmpty = false;
-    is.close();
 
-    //Output the table of documents and total words
-    std::ifstream ifs;
-    ifs.open(getWordCount());
+    //Get the document table, so document IDs match the postings
+    file.readDocuments(Parser::documents);
 
-    int numWords;
-    ifs >> numWords;
-
-    std::string doc;
-    int total;
-    for(int i{}; i < numWords; i++)
+    //Get most frequent words
+    frequentWords.clear();
+    for(const std::string& word : file.getFrequentWords())
     {
-        ifs >> doc >> total;
-        Parser::totalWordsInDoc[doc] = total;
+        frequentWords.update(table.getWord(word));
     }
-    ifs.close();
-
-    loadFrequencyList();
     return true;
 }
 
+/**
+ *
+ * loadWords(IndexFile&)
+ *
+ * Adds every word of an index file or segment to the table. A word that is
+ * already in the table gains the documents of the new one.
+ *
+ * @param file  - the open index file or segment
+ */
+void HashIndex::loadWords(IndexFile& file)
+{
+    for(int i{}; i < file.getNumTerms(); i++)
+    {
+        Word word{file.getWord(i)};
+        int size = table.getSize();
+        Word& inserted = table.insert(word);
+        if(table.getSize() == size)
+            inserted.merge(word);
+    }
+}
+
 /**
  *
  * clear()
@@ -214,36 +188,21 @@ void HashIndex::clear()
 {
     isEmpty = true;
     table.clear();
+    frequentWords.clear();
+    markAllChanged();
 }
 
 /**
  *
  * printToFile()
  *
- * Prints the PDF index to the index file, and prints the table of
- * document-total word combinations to the wordCount file.
+ * Prints the PDF index and the table of document-total word combinations
+ * to the index file.
  *
  */
 void HashIndex::printToFile()
 {
-    //Opening the index file
-    std::ofstream o;
-    o.open(getIndexFile());
-    o << indexDirectory << "\t";
-    o << "HASH" << "\t" << Parser::getNumFiles() << "\t";
-    o << Parser::getNumPages() << "\t" << Parser::getNumWords() << std::endl;
-    o << table;
-    o.close();
-
-    //Opens the wordCount file
-    o.open(getWordCount());
-    o << Parser::totalWordsInDoc.size() << std::endl;
-    for(auto it = Parser::totalWordsInDoc.begin(); it != Parser::totalWordsInDoc.end(); ++it)
-    {
-        o << it->first << "\t" << it->second << std::endl;
-    }
-    o.close();
-
+    IndexFile::write(getIndexFile(), *this);
 }
 
 
@@ -252,85 +211,19 @@ void HashIndex::printToFile()
  */
 HashIndex::~HashIndex() {}
 
-/**
- *
- * getHeight(Node<Word>*& node)
- *
- * Helper function to load each AVL tree of the hash table
- *
- * @param node  - the head of each tree in the hash table
- * @return      - the height of each node, -1 if nullptr
- */
-int HashIndex::getHeight(Node<Word>*& node)
-{
-    return (node == nullptr) ? -1 : node->height;
-}
-
 /**
  *
  * addToFrequencyList(Word&)
  *
- * Adds the Word object to the list of frequent words if it happens to be
- * in the index frequently. Otherwise, nothing happens.
+ * Updates the list of frequent words after a word has been inserted or its
+ * frequency has grown. Words that are not frequent enough are rejected
+ * without searching the list.
  *
  * @param word  - the Word object to check against and add to the list
  */
 void HashIndex::addToFrequencyList(Word& word)
 {
-    //Check if the word doesn't exist, add it
-    if(std::find(frequentWords.begin(), frequentWords.end(), &word) == frequentWords.end())
-        frequentWords.push_back(&word);
-
-    //Sort the list by the frequency of the word
-    std::sort(frequentWords.begin(), frequentWords.end(), [](Word*& lhs, Word*& rhs)
-    {
-        return lhs->getTotalFrequency() > rhs->getTotalFrequency();
-    });
-
-    //If the size is greater than 50, get rid of the smallest values
-    if(frequentWords.size() >= 50)
-    {
-        while(frequentWords.size() != 50)
-        {
-            frequentWords.pop_back();
-        }
-    }
-}
-
-
-/**
- *
- * loadFrequencyList(Node<Word>*)
- *
- * Recursively moves through each node within the given Node<Word> (presumably
- * an AVL tree) to find the most frequent words within the index.
- *
- * @param head  - the head of the tree within the hash table
- */
-void HashIndex::loadFrequencyList(Node<Word>* head)
-{
-    if(head == nullptr)
-        return;
-    else
-    {
-        addToFrequencyList(head->data);
-        loadFrequencyList(head->left);
-        loadFrequencyList(head->right);
-    }
-    return;
-
-}
-
-/**
- * Finds all words that should be in the most frequent words using
- * the helper function loadFrequencyList(Node<Word>*)
- */
-void HashIndex::loadFrequencyList()
-{
-    for(int i{}; i < LENGTH; i++)
-    {
-        loadFrequencyList(table[i].head);
-    }
+    frequentWords.update(word);
 }
 
 /**
@@ -340,53 +233,22 @@ void HashIndex::loadFrequencyList()
  */
 void HashIndex::printFrequencyList()
 {
-    for(Word* w : frequentWords)
+    for(Word* w : getFrequentWords())
         std::cout << w->getWord() << "\t" << w->getTotalFrequency() << " times" << std::endl;
 }
 
 /**
- * recalculateRanking()
  *
- * Recalculates the ranking of all elements within the hash table using
- * the recalcRankingHelper function
- */
-void HashIndex::recalculateRanking()
-{
-    for(int i{}; i < LENGTH; i++)
-        recalcRankingHelper(table[i].head);
-}
-
-/**
- *
- * loadTree(Node<Word>* node, std::istream&)
+ * getWords(std::vector<Word*>&)
  *
- * Helper function to load an AVL tree from an istream to the given node.
- * When the function is complete, the whole AVL tree for the istream should
- * be added.
+ * Adds a pointer to every word within the hash table to the vector.
  *
- * @param node  - the node to add to the tree
- * @param is    - the stream to take data from
- * @return      - the head node of the new tree
+ * @param words - the vector to add the words to
  */
-Node<Word>* HashIndex::loadTree(Node<Word>* node, std::istream& is)
+void HashIndex::getWords(std::vector<Word*>& words)
 {
-    std::string buf;
-    //Checks if the end of the tree has been found
-    while(is >> buf && buf != "end---------------------------------")
-    {
-        //Null pointer delimiter
-        if(buf == "$$$")
-            return nullptr;
-        else
-        {
-            node = new Node<Word>(Word(buf, is));
-            node->left = loadTree(node->left, is);
-            node->right = loadTree(node->right, is);
-            node->height = std::max(getHeight(node->left), getHeight(node->right)) + 1;
-            return node;
-        }
-    }
-    return node;
+    for(int i{}; i < table.getSize(); i++)
+        words.push_back(&table[i]);
 }
 
 /**
@@ -2,12 +2,13 @@
 
 #include <Index/indexinterface.h>
 #include <HashTable/hashtable.h>
+#include <Index/indexfile.h>
 
 /**
  *
  * HashIndex is a subclass of IndexInterface, and is an implementation
- * of its parent class with a hash table. The hash table contains an
- * array of AVL trees.
+ * of its parent class with a hash table. The hash table is an
+ * open-addressing table of the words in the index.
  *
  * By: Oisin Coveney
  *
@@ -19,8 +20,8 @@ class HashIndex : public IndexInterface
         HashTable table;
         bool isEmpty;
 
-        //Helper for recalculating the ranking of all elements
-        void recalcRankingHelper(Node<Word>*& node);
+        //Add the words of an index file or segment
+        void loadWords(IndexFile& file);
 
     public:
         //Constructor
@@ -28,7 +29,7 @@ class HashIndex : public IndexInterface
 
         //Insertion functions
         Word& insert(std::__cxx11::string& word) override;
-        void insert(std::__cxx11::string& word, std::__cxx11::string& document) override;
+        void insert(std::__cxx11::string& word, uint32_t document) override;
         void insert(Word word);
 
         //Check if empty
@@ -37,6 +38,9 @@ class HashIndex : public IndexInterface
         //Return reference to Word
         Word& get(const std::__cxx11::string& word) override;
 
+        //Collect every word in the table
+        void getWords(std::vector<Word*>& words) override;
+
         //Clear index
         void clear() override;
 
@@ -53,19 +57,10 @@ class HashIndex : public IndexInterface
         //operator << overload
         friend std::ostream& operator<<(std::ostream& o, const HashIndex& index);
 
-        //Load tree from istream
-        Node<Word>*loadTree(Node<Word>* node, std::istream& is);
-        int getHeight(Node<Word>*& node);
-
         //Frequency List functions
         void addToFrequencyList(Word& word) override;
-        void loadFrequencyList(Node<Word>* head);
-        void loadFrequencyList();
         void printFrequencyList() override;
 
-        //Recalculate ranking
-        void recalculateRanking() override;
-
         //get directory from file
         std::string getDirectoryFromFile() override;
 
@@ -0,0 +1,912 @@
+#include <Index/indexfile.h>
+#include <Index/indexinterface.h>
+
+#include <cstring>
+#include <cstdio>
+#include <unordered_map>
+#include <experimental/filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+const char IndexFile::MAGIC[8] = {'P', 'D', 'F', 'I', 'N', 'D', 'X', '\0'};
+const uint32_t IndexFile::DOCUMENT_REMOVED;
+const uint32_t IndexFile::DOCUMENT_TOMBSTONE;
+
+/**
+ * align(uint64_t)
+ *
+ * @param offset    - an offset into the file
+ * @return          - the offset rounded up to a multiple of 8
+ */
+static uint64_t align(uint64_t offset)
+{
+    return (offset + 7) & ~((uint64_t) 7);
+}
+
+/**
+ * Destructor
+ */
+IndexFile::~IndexFile()
+{
+    close();
+}
+
+/**
+ *
+ * open(const std::string&)
+ *
+ * Maps the index file into memory and checks that it is a valid index.
+ * The mapping is read-only and shared, so every process that opens the
+ * same index shares its pages, and it is unmapped once neither this
+ * IndexFile nor any copy of it holds it.
+ *
+ * @param file  - the path of the index file
+ * @return      - true if the file was mapped and is valid, false if not
+ */
+bool IndexFile::open(const std::string& file)
+{
+    close();
+
+    int fd = ::open(file.c_str(), O_RDONLY);
+    if(fd < 0)
+        return false;
+
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(Header))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(mapped == MAP_FAILED)
+        return false;
+
+    path = file;
+    data = (const char*) mapped;
+    size = st.st_size;
+    size_t length = size;
+    mapping.reset(data, [length](const char* mapped)
+    {
+        munmap((void*) mapped, length);
+    });
+
+    if(!validate())
+    {
+        close();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * close()
+ *
+ * Lets go of the mapping of the index file, which is unmapped unless a
+ * copy still holds it.
+ */
+void IndexFile::close()
+{
+    mapping.reset();
+    path.clear();
+    data = nullptr;
+    size = 0;
+    header = nullptr;
+    documents = nullptr;
+    terms = nullptr;
+    frequent = nullptr;
+    segments = nullptr;
+}
+
+/**
+ * isOpen()
+ * @return  - true if an index file is mapped, false if not
+ */
+bool IndexFile::isOpen() const
+{
+    return data != nullptr;
+}
+
+/**
+ * sharesMapping(const IndexFile&)
+ * @param other - another IndexFile
+ * @return      - true if both are copies of the same opened file, false if
+ *                not, even if a file was rewritten under the same path
+ */
+bool IndexFile::sharesMapping(const IndexFile& other) const
+{
+    return mapping != nullptr && mapping == other.mapping;
+}
+
+/**
+ *
+ * validate()
+ *
+ * Checks the magic number, version, and byte order of the mapped file,
+ * and that every section lies within the file, in order, after the header.
+ * The strings that entries refer to are checked when they are read, so
+ * opening a file doesn't read every entry, apart from the names of the
+ * segments. Those must be bare file names, since the segments are deleted
+ * once they are merged, and a name such as "../x" would leave the
+ * directory of the index.
+ *
+ * @return  - true if the file is a valid index, false if not
+ */
+bool IndexFile::validate()
+{
+    header = (const Header*) data;
+
+    if(std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0
+            || header->version != FORMAT_VERSION
+            || header->byteOrder != ORDER_MARK
+            || header->fileSize != size)
+        return false;
+
+    //Every offset is checked against the size first, so the sums below can't overflow
+    if(header->documentsOffset < sizeof(Header)
+            || header->documentsOffset > size || header->termsOffset > size
+            || header->postingsOffset > size || header->frequentOffset > size
+            || header->segmentsOffset > size || header->stringsOffset > size)
+        return false;
+
+    if(header->documentsOffset + (uint64_t) header->numDocuments * sizeof(DocumentEntry) > header->termsOffset
+            || header->termsOffset + (uint64_t) header->numTerms * sizeof(TermEntry) > header->postingsOffset
+            || header->postingsOffset > header->frequentOffset
+            || header->frequentOffset + (uint64_t) header->numFrequent * sizeof(FrequentEntry) > header->segmentsOffset
+            || header->segmentsOffset + (uint64_t) header->numSegments * sizeof(SegmentEntry) > header->stringsOffset
+            || !inStrings(header->directoryOffset, header->directoryLength))
+        return false;
+
+    documents = (const DocumentEntry*) (data + header->documentsOffset);
+    terms = (const TermEntry*) (data + header->termsOffset);
+    frequent = (const FrequentEntry*) (data + header->frequentOffset);
+    segments = (const SegmentEntry*) (data + header->segmentsOffset);
+
+    for(uint32_t i{}; i < header->numSegments; i++)
+    {
+        std::string name{getString(segments[i].nameOffset, segments[i].nameLength)};
+        if(name.empty() || name == "." || name == ".." || name.find('/') != std::string::npos)
+            return false;
+    }
+    return true;
+}
+
+/**
+ *
+ * inStrings(uint64_t, uint64_t)
+ *
+ * @param offset    - the offset of a string within the strings of the file
+ * @param length    - the length of the string
+ * @return          - true if the string lies within the file, false if not
+ */
+bool IndexFile::inStrings(uint64_t offset, uint64_t length) const
+{
+    uint64_t stringsSize = size - header->stringsOffset;
+    return offset <= stringsSize && length <= stringsSize - offset;
+}
+
+/**
+ *
+ * getString(uint64_t, uint32_t)
+ *
+ * @param offset    - the offset of a string within the strings of the file
+ * @param length    - the length of the string
+ * @return          - the string, or an empty string if it doesn't lie
+ *                    within the file
+ */
+std::string IndexFile::getString(uint64_t offset, uint32_t length) const
+{
+    //Invalid strings are left empty
+    if(!inStrings(offset, length))
+        return "";
+
+    return std::string(data + header->stringsOffset + offset, length);
+}
+
+/**
+ *
+ * write(const std::string&, IndexInterface&)
+ *
+ * Writes the whole index to a single file: the words of the index, the
+ * document table, and the corpus counts of the Parser. Any segment files
+ * the old index file listed are deleted once the new file is in place.
+ *
+ * @param file  - the path of the index file
+ * @param index - the index to write
+ * @return      - true if the file was written, false if not
+ */
+bool IndexFile::write(const std::string& file, IndexInterface& index)
+{
+    std::vector<Word*> words;
+    index.getWords(words);
+    return writeFile(file, &index, words, Parser::documents.size(), index.getFrequentWords(),
+                     std::vector<std::string>{});
+}
+
+/**
+ *
+ * writeSegment(const std::string&, std::vector<Word*>&)
+ *
+ * Writes a segment file, which holds only the terms and postings of the
+ * given words. A segment has no documents or counts of its own, and is
+ * never changed once it has been written. Segments don't read the Parser,
+ * so they can be written on any thread.
+ *
+ * @param file      - the path of the segment file
+ * @param words     - the words of the segment, which are sorted
+ * @param idLimit   - a limit on the document IDs of the postings
+ * @return          - true if the file was written, false if not
+ */
+bool IndexFile::writeSegment(const std::string& file, std::vector<Word*>& words,
+                             uint32_t idLimit)
+{
+    return writeFile(file, nullptr, words, idLimit, std::vector<Word*>{},
+                     std::vector<std::string>{});
+}
+
+/**
+ *
+ * SegmentWriter(const std::string&)
+ *
+ * Starts writing a segment, opening the temporary file of its postings.
+ *
+ * @param file  - the path of the segment file
+ */
+IndexFile::SegmentWriter::SegmentWriter(const std::string& file)
+    : file{file}, postingsFile{file + ".postings.tmp"},
+      postings{postingsFile, std::ios::binary | std::ios::trunc}, postingsSize{0},
+      termTable{}, strings{}, serialized{} {}
+
+/**
+ * Destructor
+ *
+ * Deletes the temporary file of the postings, whether or not the segment
+ * was finished.
+ */
+IndexFile::SegmentWriter::~SegmentWriter()
+{
+    postings.close();
+    std::remove(postingsFile.c_str());
+}
+
+/**
+ *
+ * add(const Word&)
+ *
+ * Writes the postings of a word and adds it to the term dictionary. Words
+ * must be added in sorted order, and words without documents are dropped.
+ *
+ * @param word  - the word to add
+ */
+void IndexFile::SegmentWriter::add(const Word& word)
+{
+    if(word.getNumDocs() == 0)
+        return;
+
+    serialized.clear();
+    word.getPostings().serialize(serialized);
+    postings.write(serialized.data(), serialized.size());
+
+    const std::string& term = word.getWord();
+    termTable.push_back(TermEntry{strings.size(), (uint32_t) term.size(),
+                                  word.getTotalFrequency(), (uint32_t) word.getNumDocs(), 0,
+                                  postingsSize, serialized.size()});
+    postingsSize += serialized.size();
+    strings += term;
+}
+
+/**
+ *
+ * finish(uint32_t)
+ *
+ * Writes the segment file in the same layout as writeSegment(), copying
+ * the postings from their temporary file a block at a time. The file is
+ * written under a temporary name and then renamed.
+ *
+ * @param idLimit   - a limit on the document IDs of the postings
+ * @return          - true if the file was written, false if not
+ */
+bool IndexFile::SegmentWriter::finish(uint32_t idLimit)
+{
+    postings.close();
+    if(!postings)
+        return false;
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.byteOrder = ORDER_MARK;
+    h.idLimit = idLimit;
+
+    h.numTerms = termTable.size();
+    h.documentsOffset = align(sizeof(Header));
+    h.termsOffset = h.documentsOffset;
+    h.postingsOffset = h.termsOffset + termTable.size() * sizeof(TermEntry);
+    h.frequentOffset = align(h.postingsOffset + postingsSize);
+    h.segmentsOffset = h.frequentOffset;
+    h.stringsOffset = h.segmentsOffset;
+    h.fileSize = h.stringsOffset + strings.size();
+
+    for(TermEntry& t : termTable)
+        t.postingsOffset += h.postingsOffset;
+
+    std::string temp = file + ".tmp";
+    std::ofstream o(temp, std::ios::binary | std::ios::trunc);
+    const char padding[8] = {};
+
+    o.write((const char*) &h, sizeof(h));
+    o.write(padding, h.documentsOffset - sizeof(h));
+    o.write((const char*) termTable.data(), termTable.size() * sizeof(TermEntry));
+
+    std::ifstream in(postingsFile, std::ios::binary);
+    std::vector<char> block(1 << 16);
+    uint64_t copied{0};
+    while(in.read(block.data(), block.size()) || in.gcount() > 0)
+    {
+        o.write(block.data(), in.gcount());
+        copied += in.gcount();
+    }
+
+    o.write(padding, h.frequentOffset - (h.postingsOffset + postingsSize));
+    o.write(strings.data(), strings.size());
+    o.close();
+
+    if(!o || copied != postingsSize || std::rename(temp.c_str(), file.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ *
+ * writeManifest(const std::string&, IndexInterface&, vector<string>, vector<Word*>)
+ *
+ * Writes an index file that holds the document table, the corpus counts,
+ * and the most frequent words, and lists the segment files holding the
+ * words of the index. Segment files the old index file listed that the
+ * new one doesn't are deleted once the new file is in place.
+ *
+ * @param file          - the path of the index file
+ * @param index         - the index whose directory is written
+ * @param segmentFiles  - the paths of the segment files, which must be in
+ *                        the same directory as the index file
+ * @param frequentWords - the most frequent words and their total frequency
+ * @return              - true if the file was written, false if not
+ */
+bool IndexFile::writeManifest(const std::string& file, IndexInterface& index,
+                              const std::vector<std::string>& segmentFiles,
+                              const std::vector<Word*>& frequentWords)
+{
+    std::vector<Word*> words;
+    return writeFile(file, &index, words, Parser::documents.size(), frequentWords, segmentFiles);
+}
+
+/**
+ *
+ * replaceSegments(const std::string&, vector<string>, const std::string&)
+ *
+ * Rewrites an index file so it lists a merged segment in place of the
+ * segments that were merged into it, and deletes the merged segments.
+ * Everything before the list of segments is copied as it is, apart from
+ * the tombstone flags of documents whose postings were compacted away, and
+ * the names of new segments are added to the end of the strings, so no
+ * other offset changes. The file is written under a temporary name and
+ * then renamed.
+ *
+ * @param file      - the path of the index file
+ * @param merged    - the paths of the segments that were merged
+ * @param segment   - the path of the segment they were merged into
+ * @param compacted - the tombstones whose postings are in no segment left
+ * @return          - true if the file was rewritten, false if it couldn't be
+ *                    read or written, or doesn't list every merged segment
+ */
+bool IndexFile::replaceSegments(const std::string& file,
+                                const std::vector<std::string>& merged,
+                                const std::string& segment,
+                                const PostingList& compacted)
+{
+    namespace fs = std::experimental::filesystem;
+
+    IndexFile old;
+    if(!old.open(file))
+        return false;
+
+    //Keep the segments that weren't merged
+    std::vector<SegmentEntry> segmentTable;
+    std::string strings(old.data + old.header->stringsOffset,
+                        old.size - old.header->stringsOffset);
+    std::vector<std::string> oldSegments{old.getSegments()};
+    size_t numMerged{0};
+    for(uint32_t i{}; i < old.header->numSegments; i++)
+    {
+        bool wasMerged{false};
+        for(const std::string& m : merged)
+            wasMerged = wasMerged || fs::path(m).filename() == fs::path(oldSegments[i]).filename();
+
+        if(wasMerged)
+            numMerged++;
+        else
+            segmentTable.push_back(old.segments[i]);
+    }
+    if(numMerged != merged.size())
+        return false;
+
+    std::string name = fs::path(segment).filename();
+    IndexFile f;
+    uint32_t numTerms = f.open(segment) ? f.getNumTerms() : 0;
+    segmentTable.push_back(SegmentEntry{strings.size(), (uint32_t) name.size(),
+                                        numTerms, (uint64_t) f.size});
+    strings += name;
+
+    Header h{*old.header};
+    h.numSegments = segmentTable.size();
+    h.stringsOffset = h.segmentsOffset + segmentTable.size() * sizeof(SegmentEntry);
+    h.fileSize = h.stringsOffset + strings.size();
+
+    //Documents whose postings were compacted away are no longer tombstones
+    std::string sections(old.data + sizeof(h), h.segmentsOffset - sizeof(h));
+    for(PostingList::Cursor c{compacted}; c.valid() && c.id() < h.numDocuments; c.next())
+    {
+        size_t offset = h.documentsOffset - sizeof(h) + c.id() * sizeof(DocumentEntry);
+        DocumentEntry d;
+        std::memcpy(&d, &sections[offset], sizeof(d));
+        d.flags &= ~DOCUMENT_TOMBSTONE;
+        std::memcpy(&sections[offset], &d, sizeof(d));
+    }
+
+    std::string temp = file + ".tmp";
+    std::ofstream o(temp, std::ios::binary | std::ios::trunc);
+    o.write((const char*) &h, sizeof(h));
+    o.write(sections.data(), sections.size());
+    o.write((const char*) segmentTable.data(), segmentTable.size() * sizeof(SegmentEntry));
+    o.write(strings.data(), strings.size());
+    o.close();
+
+    if(!o || std::rename(temp.c_str(), file.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    for(const std::string& m : merged)
+        std::remove(m.c_str());
+    return true;
+}
+
+/**
+ *
+ * writeFile(const std::string&, IndexInterface*, vector<Word*>, vector<Word*>, vector<string>)
+ *
+ * Writes the sections of a file. If an index is given, the document table
+ * and the corpus counts of the Parser are written along with the index's
+ * directory. Postings store the document IDs of the Parser's DocumentTable,
+ * and the document table is written in ID order, along with the manifest
+ * of each document's file. Removed documents are kept so the IDs stay the
+ * same, and those whose postings haven't been compacted yet are marked as
+ * tombstones. Words left without documents are dropped.
+ *
+ * The file is written under a temporary name and then renamed, so
+ * processes that have the old file mapped are not affected.
+ *
+ * @param file          - the path of the file
+ * @param index         - the index whose documents are written, or nullptr
+ *                        to write a segment
+ * @param words         - the words to write, which are sorted
+ * @param idLimit       - a limit on the document IDs of the postings
+ * @param frequentWords - the most frequent words
+ * @param segmentFiles  - the paths of the segment files to list
+ * @return              - true if the file was written, false if not
+ */
+bool IndexFile::writeFile(const std::string& file, IndexInterface* index,
+                          std::vector<Word*>& words, uint32_t idLimit,
+                          const std::vector<Word*>& frequentWords,
+                          const std::vector<std::string>& segmentFiles)
+{
+    namespace fs = std::experimental::filesystem;
+    std::string strings;
+
+    Header h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = FORMAT_VERSION;
+    h.byteOrder = ORDER_MARK;
+    h.idLimit = idLimit;
+
+    //Document table, in order of document ID
+    std::vector<DocumentEntry> documentTable;
+    if(index != nullptr)
+    {
+        h.numFiles = Parser::getNumFiles();
+        h.numPages = Parser::getNumPages();
+        h.numWords = Parser::getNumWords();
+
+        std::string directory = index->getIndexDirectory();
+        h.directoryOffset = strings.size();
+        h.directoryLength = directory.size();
+        strings += directory;
+
+        PostingList::Cursor tombstone{Parser::documents.getTombstones()};
+        for(int id{}; id < Parser::documents.size(); id++)
+        {
+            const std::string& path = Parser::documents.getPath(id);
+            const FileInfo& info = Parser::documents.getFileInfo(id);
+            uint32_t flags = Parser::documents.isRemoved(id) ? DOCUMENT_REMOVED : 0;
+
+            tombstone.skipTo(id);
+            if(tombstone.valid() && tombstone.id() == (uint32_t) id)
+                flags |= DOCUMENT_TOMBSTONE;
+
+            documentTable.push_back(DocumentEntry{strings.size(), (uint32_t) path.size(),
+                                                  Parser::documents.getWordCount(id),
+                                                  Parser::documents.getPageCount(id), flags,
+                                                  info.size, info.modifiedTime, info.contentHash});
+            strings += path;
+        }
+    }
+
+    //Term dictionary and postings, sorted by word
+    words.erase(std::remove_if(words.begin(), words.end(), [](Word* w)
+    {
+        return w->getNumDocs() == 0;
+    }), words.end());
+    std::sort(words.begin(), words.end(), [](Word* lhs, Word* rhs)
+    {
+        return lhs->getWord() < rhs->getWord();
+    });
+
+    std::vector<TermEntry> termTable;
+    std::string postings;
+    for(Word* w : words)
+    {
+        const std::string& term = w->getWord();
+        uint64_t offset = postings.size();
+        w->getPostings().serialize(postings);
+        termTable.push_back(TermEntry{strings.size(), (uint32_t) term.size(),
+                                      w->getTotalFrequency(), (uint32_t) w->getNumDocs(), 0,
+                                      offset, postings.size() - offset});
+        strings += term;
+    }
+
+    //Most frequent words
+    std::vector<FrequentEntry> frequentTable;
+    for(Word* w : frequentWords)
+    {
+        frequentTable.push_back(FrequentEntry{strings.size(), (uint32_t) w->getWord().size(),
+                                              w->getTotalFrequency()});
+        strings += w->getWord();
+    }
+
+    //Segment files, by name within the directory of this file
+    std::vector<SegmentEntry> segmentTable;
+    for(const std::string& segment : segmentFiles)
+    {
+        std::string name = fs::path(segment).filename();
+        IndexFile f;
+        uint32_t numTerms = f.open(segment) ? f.getNumTerms() : 0;
+        segmentTable.push_back(SegmentEntry{strings.size(), (uint32_t) name.size(),
+                                            numTerms, (uint64_t) f.size});
+        strings += name;
+    }
+
+    //Section offsets
+    h.numDocuments = documentTable.size();
+    h.numTerms = termTable.size();
+    h.numFrequent = frequentTable.size();
+    h.numSegments = segmentTable.size();
+    h.documentsOffset = align(sizeof(Header));
+    h.termsOffset = h.documentsOffset + documentTable.size() * sizeof(DocumentEntry);
+    h.postingsOffset = h.termsOffset + termTable.size() * sizeof(TermEntry);
+    h.frequentOffset = align(h.postingsOffset + postings.size());
+    h.segmentsOffset = h.frequentOffset + frequentTable.size() * sizeof(FrequentEntry);
+    h.stringsOffset = h.segmentsOffset + segmentTable.size() * sizeof(SegmentEntry);
+    h.fileSize = h.stringsOffset + strings.size();
+
+    for(TermEntry& t : termTable)
+        t.postingsOffset += h.postingsOffset;
+
+    //Segments listed by the file being replaced
+    std::vector<std::string> oldSegments;
+    if(index != nullptr)
+    {
+        IndexFile old;
+        if(old.open(file))
+            oldSegments = old.getSegments();
+    }
+
+    //Write the sections in order
+    std::string temp = file + ".tmp";
+    std::ofstream o(temp, std::ios::binary | std::ios::trunc);
+    const char padding[8] = {};
+
+    o.write((const char*) &h, sizeof(h));
+    o.write(padding, h.documentsOffset - sizeof(h));
+    o.write((const char*) documentTable.data(), documentTable.size() * sizeof(DocumentEntry));
+    o.write((const char*) termTable.data(), termTable.size() * sizeof(TermEntry));
+    o.write(postings.data(), postings.size());
+    o.write(padding, h.frequentOffset - (h.postingsOffset + postings.size()));
+    o.write((const char*) frequentTable.data(), frequentTable.size() * sizeof(FrequentEntry));
+    o.write((const char*) segmentTable.data(), segmentTable.size() * sizeof(SegmentEntry));
+    o.write(strings.data(), strings.size());
+    o.close();
+
+    if(!o || std::rename(temp.c_str(), file.c_str()) != 0)
+    {
+        std::remove(temp.c_str());
+        return false;
+    }
+
+    //Delete the segments that are no longer listed
+    for(const std::string& segment : oldSegments)
+    {
+        bool listed{false};
+        for(const std::string& other : segmentFiles)
+            listed = listed || fs::path(other).filename() == fs::path(segment).filename();
+        if(!listed)
+            std::remove(segment.c_str());
+    }
+    return true;
+}
+
+/**
+ * getDirectory()
+ * @return  - the directory the index was built from
+ */
+std::string IndexFile::getDirectory() const
+{
+    return getString(header->directoryOffset, header->directoryLength);
+}
+
+int IndexFile::getNumFiles() const
+{
+    return header->numFiles;
+}
+
+int IndexFile::getNumPages() const
+{
+    return header->numPages;
+}
+
+int IndexFile::getNumWords() const
+{
+    return header->numWords;
+}
+
+int IndexFile::getNumDocuments() const
+{
+    return header->numDocuments;
+}
+
+int IndexFile::getNumTerms() const
+{
+    return header->numTerms;
+}
+
+/**
+ * getDocument(int)
+ *
+ * @param document  - the ID of the document within the document table
+ * @return          - the full path of the document
+ */
+std::string IndexFile::getDocument(int document) const
+{
+    const DocumentEntry& d = documents[document];
+    return getString(d.nameOffset, d.nameLength);
+}
+
+/**
+ * getWordCount(int)
+ *
+ * @param document  - the ID of the document within the document table
+ * @return          - the number of words parsed from the document
+ */
+int IndexFile::getWordCount(int document) const
+{
+    return documents[document].wordCount;
+}
+
+/**
+ *
+ * readDocuments(DocumentTable&)
+ *
+ * Replaces the contents of a DocumentTable with the documents of the file,
+ * in ID order so the IDs match the postings. Removed documents are added
+ * and removed again, which keeps their IDs, and the documents marked as
+ * tombstones become the tombstones of the table.
+ *
+ * @param table - the DocumentTable to read the documents into
+ */
+void IndexFile::readDocuments(DocumentTable& table) const
+{
+    table.clear();
+    PostingList tombstones;
+    for(int i{}; i < getNumDocuments(); i++)
+    {
+        const DocumentEntry& d = documents[i];
+        uint32_t id = table.add(getDocument(i));
+
+        FileInfo info;
+        info.size = d.fileSize;
+        info.modifiedTime = d.modifiedTime;
+        info.contentHash = d.contentHash;
+        table.setFileInfo(id, info);
+        table.setWordCount(id, d.wordCount);
+        table.setPageCount(id, d.pageCount);
+
+        if(d.flags & DOCUMENT_REMOVED)
+            table.remove(id);
+        if(d.flags & DOCUMENT_TOMBSTONE)
+            tombstones.append(id, 1);
+    }
+    table.setTombstones(tombstones);
+}
+
+/**
+ * getTerm(int)
+ *
+ * @param term  - the number of the term within the term dictionary
+ * @return      - the word of the term
+ */
+std::string IndexFile::getTerm(int term) const
+{
+    const TermEntry& t = terms[term];
+    return getString(t.nameOffset, t.nameLength);
+}
+
+/**
+ * getTotalFrequency(int)
+ *
+ * @param term  - the number of the term within the term dictionary
+ * @return      - the number of times the word occurs in the documents
+ */
+int IndexFile::getTotalFrequency(int term) const
+{
+    return terms[term].totalFrequency;
+}
+
+/**
+ *
+ * findTerm(const std::string&)
+ *
+ * Binary searches the sorted term dictionary within the mapped file. A
+ * term whose word doesn't lie within the file is compared as if it were
+ * empty.
+ *
+ * @param word  - the word to search for
+ * @return      - the number of the term, -1 if the word isn't in the index
+ */
+int IndexFile::findTerm(const std::string& word) const
+{
+    int low{0}, high{(int) header->numTerms - 1};
+    while(low <= high)
+    {
+        int mid = low + (high - low) / 2;
+        const TermEntry& t = terms[mid];
+
+        size_t nameLength = inStrings(t.nameOffset, t.nameLength) ? t.nameLength : 0;
+        size_t length = std::min(nameLength, word.size());
+        int cmp = std::memcmp(data + header->stringsOffset + t.nameOffset,
+                              word.data(), length);
+        if(cmp == 0)
+            cmp = (nameLength < word.size()) ? -1 : (nameLength > word.size());
+
+        if(cmp == 0)
+            return mid;
+        else if(cmp < 0)
+            low = mid + 1;
+        else
+            high = mid - 1;
+    }
+    return -1;
+}
+
+/**
+ *
+ * getWord(int)
+ *
+ * Decodes a single term and its postings into a Word object.
+ *
+ * @param term  - the number of the term within the term dictionary
+ * @return      - the Word object containing the term's documents
+ */
+Word IndexFile::getWord(int term) const
+{
+    const TermEntry& t = terms[term];
+
+    //Invalid postings are left empty
+    PostingList postings;
+    if(t.postingsOffset >= header->postingsOffset
+            && t.postingsOffset <= header->frequentOffset
+            && t.postingsLength <= header->frequentOffset - t.postingsOffset)
+        postings.deserialize(data + t.postingsOffset, t.postingsLength,
+                            t.numPostings, header->idLimit);
+
+    return Word(getTerm(term), postings, t.totalFrequency);
+}
+
+/**
+ * getFrequentWords()
+ *
+ * @return  - the most frequent words, most frequent first
+ */
+std::vector<std::string> IndexFile::getFrequentWords() const
+{
+    std::vector<std::string> frequentWords;
+    for(uint32_t i{}; i < header->numFrequent; i++)
+    {
+        const FrequentEntry& f = frequent[i];
+        frequentWords.push_back(getString(f.nameOffset, f.nameLength));
+    }
+    return frequentWords;
+}
+
+/**
+ *
+ * getFrequentSummary()
+ *
+ * Reads the most frequent words along with their total frequency, without
+ * decoding their postings, which are the longest in the index.
+ *
+ * @return  - Words holding the name and total frequency of each frequent
+ *            word, most frequent first
+ */
+std::vector<Word> IndexFile::getFrequentSummary() const
+{
+    std::vector<Word> summary;
+    std::vector<std::string> names{getFrequentWords()};
+    for(uint32_t i{}; i < header->numFrequent; i++)
+        summary.push_back(Word(names[i], PostingList(), frequent[i].totalFrequency));
+    return summary;
+}
+
+/**
+ * getSegments()
+ *
+ * @return  - the full paths of the segment files listed by the file
+ */
+std::vector<std::string> IndexFile::getSegments() const
+{
+    namespace fs = std::experimental::filesystem;
+    fs::path directory = fs::path(path).parent_path();
+
+    std::vector<std::string> segmentFiles;
+    for(uint32_t i{}; i < header->numSegments; i++)
+    {
+        const SegmentEntry& s = segments[i];
+        std::string name{getString(s.nameOffset, s.nameLength)};
+        segmentFiles.push_back(directory.empty() ? name : (directory / name).string());
+    }
+    return segmentFiles;
+}
+
+/**
+ * getPath()
+ * @return  - the path the file was opened from
+ */
+const std::string& IndexFile::getPath() const
+{
+    return path;
+}
+
+/**
+ * getSize()
+ * @return  - the size of the file in bytes
+ */
+size_t IndexFile::getSize() const
+{
+    return size;
+}
+
+/**
+ * getIdLimit()
+ * @return  - a limit on the document IDs of the postings within the file
+ */
+uint32_t IndexFile::getIdLimit() const
+{
+    return header->idLimit;
+}
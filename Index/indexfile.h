@@ -0,0 +1,248 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <memory>
+#include <cstdint>
+
+#include <Word/word.h>
+
+class IndexInterface;
+
+/**
+ * The IndexFile class reads and writes the persistent PDF index. The index
+ * is stored in a versioned binary format that is opened with mmap, so
+ * terms can be searched in place without reading the whole file.
+ *
+ * Layout of the file (all sections are 8-byte aligned):
+ *
+ *  Header          - magic, version, corpus counts, and section offsets
+ *  Documents       - one DocumentEntry per document: path, counts, and the
+ *                    size, modification time, and hash of its file
+ *  Terms           - one TermEntry per word, sorted by the word
+ *  Postings        - the serialized, compressed PostingList of each word
+ *  Frequent words  - the most frequent words and their total frequency
+ *  Segments        - the names of the segment files holding more terms
+ *  Strings         - the index directory, document paths, and words
+ *
+ * An index may be spread over several files. The index file itself holds
+ * the documents and counts, and may list segment files, which hold only
+ * terms and postings and are never changed once written. The words of the
+ * index are the words of the index file and of every segment, and a word
+ * found in more than one has the union of their postings.
+ *
+ * Copies of an IndexFile share its mapping, which is unmapped once the last
+ * copy is closed, so a copy can keep reading a file after it has been
+ * replaced or deleted.
+ *
+ * By: Oisin Coveney
+ */
+class IndexFile
+{
+    public:
+
+        //Identifies the file and its format
+        static const char MAGIC[8];
+        static const uint32_t FORMAT_VERSION = 6;
+        static const uint32_t ORDER_MARK = 0x01020304;
+
+        struct Header
+        {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;
+            int32_t numFiles;
+            int32_t numPages;
+            int32_t numWords;
+            uint32_t numDocuments;
+            uint32_t numTerms;
+            uint32_t numFrequent;
+            uint32_t directoryLength;
+            uint32_t numSegments;
+            uint32_t idLimit;
+            uint32_t reserved;
+            uint64_t directoryOffset;
+            uint64_t documentsOffset;
+            uint64_t termsOffset;
+            uint64_t postingsOffset;
+            uint64_t frequentOffset;
+            uint64_t segmentsOffset;
+            uint64_t stringsOffset;
+            uint64_t fileSize;
+        };
+
+        //Flags of a document: removed, and removed but with postings left
+        static const uint32_t DOCUMENT_REMOVED = 1;
+        static const uint32_t DOCUMENT_TOMBSTONE = 2;
+
+        struct DocumentEntry
+        {
+            uint64_t nameOffset;
+            uint32_t nameLength;
+            int32_t wordCount;
+            int32_t pageCount;
+            uint32_t flags;
+            uint64_t fileSize;
+            int64_t modifiedTime;
+            uint64_t contentHash;
+        };
+
+        //Rankings are calculated when a query is run, so they aren't stored
+        struct TermEntry
+        {
+            uint64_t nameOffset;
+            uint32_t nameLength;
+            int32_t totalFrequency;
+            uint32_t numPostings;
+            uint32_t reserved;
+            uint64_t postingsOffset;
+            uint64_t postingsLength;
+        };
+
+        struct FrequentEntry
+        {
+            uint64_t nameOffset;
+            uint32_t nameLength;
+            int32_t totalFrequency;
+        };
+
+        //Segment files are named relative to the directory of the index file
+        struct SegmentEntry
+        {
+            uint64_t nameOffset;
+            uint32_t nameLength;
+            uint32_t numTerms;
+            uint64_t fileSize;
+        };
+
+    private:
+
+        //The path of the file, and the mapped file, shared with every copy
+        std::string path;
+        std::shared_ptr<const char> mapping;
+        const char* data;
+        size_t size;
+
+        //Pointers into the mapped file
+        const Header* header;
+        const DocumentEntry* documents;
+        const TermEntry* terms;
+        const FrequentEntry* frequent;
+        const SegmentEntry* segments;
+
+        //Checks that the mapped file is a valid index
+        bool validate();
+
+        //Checks that a string lies within the strings of the file, and reads it
+        bool inStrings(uint64_t offset, uint64_t length) const;
+        std::string getString(uint64_t offset, uint32_t length) const;
+
+        //Write the sections of a file
+        static bool writeFile(const std::string& file, IndexInterface* index,
+                              std::vector<Word*>& words, uint32_t idLimit,
+                              const std::vector<Word*>& frequentWords,
+                              const std::vector<std::string>& segmentFiles);
+
+    public:
+
+        /**
+         * Writes a segment one word at a time, so the words of a large
+         * segment, such as one merged from every other, never have to be
+         * held in memory at once. The postings are written to a temporary
+         * file as each word is added, and only the term dictionary is kept
+         * until the segment is finished.
+         */
+        class SegmentWriter
+        {
+            private:
+
+                //The path of the segment, and the temporary file of its postings
+                std::string file;
+                std::string postingsFile;
+                std::ofstream postings;
+                uint64_t postingsSize;
+
+                //Term dictionary and the strings of its words
+                std::vector<TermEntry> termTable;
+                std::string strings;
+
+                //Serialized postings of the word being added
+                std::string serialized;
+
+            public:
+
+                SegmentWriter(const std::string& file);
+                SegmentWriter(const SegmentWriter& other) = delete;
+                SegmentWriter& operator=(const SegmentWriter& other) = delete;
+                ~SegmentWriter();
+
+                //Add a word, after every word that sorts before it
+                void add(const Word& word);
+
+                //Write the segment, once every word has been added
+                bool finish(uint32_t idLimit);
+        };
+
+        //Constructor and destructor
+        IndexFile() : path{}, mapping{}, data{nullptr}, size{0}, header{nullptr},
+            documents{nullptr}, terms{nullptr}, frequent{nullptr}, segments{nullptr} {}
+        IndexFile(const IndexFile& other) = default;
+        IndexFile& operator=(const IndexFile& other) = default;
+        ~IndexFile();
+
+        //Map the file, and let go of the mapping
+        bool open(const std::string& file);
+        void close();
+        bool isOpen() const;
+        bool sharesMapping(const IndexFile& other) const;
+
+        //Write a whole index to a file
+        static bool write(const std::string& file, IndexInterface& index);
+
+        //Write the words of a segment, or an index file that lists segments
+        static bool writeSegment(const std::string& file, std::vector<Word*>& words,
+                                 uint32_t idLimit);
+        static bool writeManifest(const std::string& file, IndexInterface& index,
+                                  const std::vector<std::string>& segmentFiles,
+                                  const std::vector<Word*>& frequentWords);
+
+        //Replace segments listed by an index file with the segment they were merged into
+        static bool replaceSegments(const std::string& file,
+                                    const std::vector<std::string>& merged,
+                                    const std::string& segment,
+                                    const PostingList& compacted = PostingList{});
+
+        //Corpus information
+        std::string getDirectory() const;
+        int getNumFiles() const;
+        int getNumPages() const;
+        int getNumWords() const;
+
+        //Documents
+        int getNumDocuments() const;
+        std::string getDocument(int document) const;
+        int getWordCount(int document) const;
+
+        //Read the table of documents and the manifest into a DocumentTable
+        void readDocuments(DocumentTable& table) const;
+
+        //Terms
+        int getNumTerms() const;
+        int findTerm(const std::string& word) const;
+        std::string getTerm(int term) const;
+        int getTotalFrequency(int term) const;
+        Word getWord(int term) const;
+
+        //Most frequent words, by name or with their total frequency but no postings
+        std::vector<std::string> getFrequentWords() const;
+        std::vector<Word> getFrequentSummary() const;
+
+        //Full paths of the segment files
+        std::vector<std::string> getSegments() const;
+        const std::string& getPath() const;
+
+        //Size of the file in bytes, and the limit of the document IDs of its postings
+        size_t getSize() const;
+        uint32_t getIdLimit() const;
+};
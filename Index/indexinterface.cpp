@@ -0,0 +1,282 @@
+#include <Index/indexinterface.h>
+#include <Index/indexsnapshot.h>
+#include <Index/indexfile.h>
+#include <Parser/parser.h>
+
+#include <thread>
+
+std::atomic<uint64_t> IndexInterface::generations{0};
+
+/**
+ *
+ * removeDocument(const std::string&)
+ *
+ * Removes a document from the index in constant time. The document is
+ * marked as removed, and its postings are left as a tombstone that is
+ * filtered out of search results until the index is compacted.
+ *
+ * @param file  - the path of the document, which is made absolute
+ * @return      - true if the document was in the index, false if not
+ */
+bool IndexInterface::removeDocument(const std::string& file)
+{
+    IndexInterface* index{this};
+    return Parser::removeDocument(file, index);
+}
+
+/**
+ *
+ * updateDocument(const std::string&)
+ *
+ * Replaces a document with the current contents of its file. The old
+ * document is removed as by removeDocument(), and the file is parsed again.
+ *
+ * @param file  - the path of the document, which is made absolute
+ */
+void IndexInterface::updateDocument(const std::string& file)
+{
+    IndexInterface* index{this};
+    std::string path{file};
+    Parser::updateDocument(path, index);
+}
+
+/**
+ *
+ * getFiles(std::vector<IndexFile>&)
+ *
+ * Adds the mapped files that hold the words of the index, which a snapshot
+ * can read in place rather than copy. An index held in memory has none.
+ *
+ * @param files - the vector to add copies of the files to
+ */
+void IndexInterface::getFiles(std::vector<IndexFile>&) {}
+
+/**
+ *
+ * getUnsavedWords(std::vector<Word*>&)
+ *
+ * Adds the words that aren't held by any file, which a snapshot copies.
+ * For an index held in memory, that is every word.
+ *
+ * @param words - the vector to add the words to
+ */
+void IndexInterface::getUnsavedWords(std::vector<Word*>& words)
+{
+    getWords(words);
+}
+
+/**
+ *
+ * findUnsaved(const std::string&)
+ *
+ * @param word  - the word to search for
+ * @return      - the part of the word that isn't held by any file, or
+ *                nullptr if there is none
+ */
+const Word* IndexInterface::findUnsaved(const std::string& word)
+{
+    try
+    {
+        return &get(word);
+    }
+    catch(std::out_of_range&)
+    {
+        return nullptr;
+    }
+}
+
+/**
+ *
+ * compact()
+ *
+ * Removes the postings of every tombstone from the words of the index,
+ * along with their occurrences of each word, and then forgets the
+ * tombstones. The words are split into one range for each of the Parser's
+ * threads, which compact their ranges at the same time. The list of most
+ * frequent words is then rebuilt, since words have lost occurrences.
+ */
+void IndexInterface::compact()
+{
+    const PostingList& dead = Parser::documents.getTombstones();
+    if(dead.empty())
+        return;
+
+    std::vector<Word*> words;
+    getWords(words);
+
+    size_t range = (words.size() + Parser::numThreads - 1) / Parser::numThreads;
+    std::vector<std::thread> threads;
+    for(size_t first{}; first < words.size(); first += range)
+    {
+        size_t last = std::min(first + range, words.size());
+        threads.push_back(std::thread([&words, &dead, first, last]
+        {
+            for(size_t i{first}; i < last; i++)
+                words[i]->removeDocs(dead);
+        }));
+    }
+    for(std::thread& t : threads)
+        t.join();
+
+    Parser::documents.clearTombstones();
+    rebuildFrequencyList();
+    markAllChanged();
+}
+
+/**
+ *
+ * publish()
+ *
+ * Publishes the current state of the index as a new IndexSnapshot, which
+ * readers on other threads can search while this index keeps changing.
+ * The first snapshot, and any snapshot after the index was loaded, cleared,
+ * or compacted, copies every word, except that an index that reads its
+ * words from files only has the words it hasn't saved copied. Otherwise
+ * only the words merged since the last snapshot are copied, and the rest
+ * are shared with it. Readers
+ * are never waited for; they keep the snapshot they already have until
+ * they ask for the new one.
+ *
+ * Only the thread that writes to the index may publish it.
+ */
+void IndexInterface::publish()
+{
+    std::shared_ptr<const IndexSnapshot> current{getSnapshot()};
+    std::shared_ptr<const IndexSnapshot> next;
+    if(current == nullptr)
+        next = IndexSnapshot::build(*this, 0);
+    else if(allWordsChanged)
+        next = IndexSnapshot::build(*this, current->getVersion() + 1);
+    else
+        next = current->update(*this, changedWords);
+
+    std::atomic_store(&snapshot, next);
+    changedWords.clear();
+    allWordsChanged = false;
+}
+
+/**
+ *
+ * getSnapshot()
+ *
+ * Gets the snapshot last published, which stays valid for as long as the
+ * caller holds it. Safe to call from any thread.
+ *
+ * @return  - the last snapshot published, or nullptr if none has been
+ */
+std::shared_ptr<const IndexSnapshot> IndexInterface::getSnapshot() const
+{
+    return std::atomic_load(&snapshot);
+}
+
+/**
+ *
+ * merge(std::vector<LocalIndex*>&, const std::vector<uint32_t>&)
+ *
+ * Merges the term maps of a batch of documents, or parts of documents,
+ * into the index. Each term map was built by the worker that parsed its
+ * document, so a word is added once per document rather than once per
+ * occurrence. The words are found in the index first, and then the
+ * postings of each partition are added by one of the Parser's threads,
+ * without any locking, since no two partitions share a word. The list of
+ * most frequent words is updated once every partition has been merged.
+ *
+ * The documents are merged in the order given, which must be the order of
+ * their IDs, so the index is the same as one built a word at a time.
+ *
+ * @param locals    - the term map of each document
+ * @param documents - the ID of each document
+ */
+void IndexInterface::merge(std::vector<LocalIndex*>& locals, const std::vector<uint32_t>& documents)
+{
+    std::vector<std::vector<Word*>> targets;
+    findWords(locals, targets);
+    mergePartitions(locals, documents, targets);
+
+    std::vector<Word*> grown;
+    for(std::vector<Word*>& words : targets)
+        grown.insert(grown.end(), words.begin(), words.end());
+    frequentWords.update(grown);
+}
+
+/**
+ *
+ * findWords(std::vector<LocalIndex*>&, std::vector<std::vector<Word*>>&)
+ *
+ * Finds the Word of every term of a batch of term maps, inserting the
+ * words that aren't in the index yet in the order they first appear. Term
+ * maps that haven't been split into partitions yet are split here. Once the
+ * index has been published, the words are remembered for the next snapshot.
+ * The index is given a new generation, since query results will change.
+ *
+ * @param locals    - the term map of each document
+ * @param targets   - filled with the Word of each term of each term map
+ */
+void IndexInterface::findWords(std::vector<LocalIndex*>& locals,
+                               std::vector<std::vector<Word*>>& targets)
+{
+    bumpGeneration();
+    targets.assign(locals.size(), std::vector<Word*>{});
+    for(size_t d{}; d < locals.size(); d++)
+    {
+        if(!locals[d]->isPartitioned())
+            locals[d]->partition();
+
+        std::vector<LocalIndex::Term>& terms = locals[d]->getTerms();
+        targets[d].reserve(terms.size());
+        for(LocalIndex::Term& term : terms)
+            targets[d].push_back(&insert(term.word));
+
+        //Remember which words to copy into the next snapshot
+        if(isPublished() && !allWordsChanged)
+        {
+            for(LocalIndex::Term& term : terms)
+                changedWords.insert(term.word);
+        }
+    }
+}
+
+/**
+ *
+ * mergePartitions(std::vector<LocalIndex*>&, const std::vector<uint32_t>&,
+ *                 std::vector<std::vector<Word*>>&)
+ *
+ * Adds the occurrences of every term of a batch of term maps to its Word.
+ * The partitions are shared out between the Parser's threads, and each
+ * thread goes through the documents in order, so the postings of every
+ * word stay sorted by ID.
+ *
+ * @param locals    - the term map of each document
+ * @param documents - the ID of each document
+ * @param targets   - the Word of each term of each term map
+ */
+void IndexInterface::mergePartitions(std::vector<LocalIndex*>& locals,
+                                     const std::vector<uint32_t>& documents,
+                                     std::vector<std::vector<Word*>>& targets)
+{
+    auto mergeRange = [&locals, &documents, &targets](int first, int step)
+    {
+        for(int p{first}; p < LocalIndex::NUM_PARTITIONS; p += step)
+        {
+            for(size_t d{}; d < locals.size(); d++)
+            {
+                std::vector<LocalIndex::Term>& terms = locals[d]->getTerms();
+                for(uint32_t i : locals[d]->getPartition(p))
+                    targets[d][i]->addDoc(documents[d], terms[i].frequency);
+            }
+        }
+    };
+
+    int numThreads = std::min(Parser::numThreads, (int) LocalIndex::NUM_PARTITIONS);
+    if(numThreads <= 1)
+    {
+        mergeRange(0, 1);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    for(int t{}; t < numThreads; t++)
+        threads.push_back(std::thread(mergeRange, t, numThreads));
+    for(std::thread& thread : threads)
+        thread.join();
+}
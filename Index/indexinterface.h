@@ -4,9 +4,17 @@
 #include <fstream>
 #include <iostream>
 #include <algorithm>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <unordered_set>
 #include <Word/word.h>
 #include <AVLTree/avltree.h>
+#include <Index/frequencylist.h>
+#include <Index/localindex.h>
 class Word;
+class IndexSnapshot;
+class IndexFile;
 
 #define MAX_FREQ 50
 
@@ -26,21 +34,31 @@ class IndexInterface
         friend class GUI;
         friend class AVLIndex;
         friend class HashIndex;
+        friend class MappedIndex;
+        friend class SegmentedIndex;
 
     private:
 
-        //persistent index
-        std::string indexFile{"index.txt"};
-
-        //table of documents and their word counts
-        std::string wordCount{"wordcount.txt"};
+        //persistent index, written by the IndexFile class
+        std::string indexFile{"index.idx"};
 
         //Table of most frequent words
-        std::vector<Word*> frequentWords{};
+        FrequencyList frequentWords{MAX_FREQ};
 
         //Directory of the words
         std::string indexDirectory;
 
+        //Read-only view of the index last published to readers, and the
+        //words that have changed since
+        std::shared_ptr<const IndexSnapshot> snapshot;
+        std::unordered_set<std::string> changedWords;
+        bool allWordsChanged{false};
+
+        //Generation of the index, which changes whenever the results of a
+        //query on it could, and is never shared by two indexes
+        static std::atomic<uint64_t> generations;
+        uint64_t generation{++generations};
+
     public:
 
         //note:a word object only needs to have 15 documents = fixed array
@@ -48,15 +66,27 @@ class IndexInterface
 
         //inserting words into index
         virtual Word& insert(std::string& word) = 0;
-        virtual void insert(std::string& word, std::string& document) = 0;
+        virtual void insert(std::string& word, uint32_t document) = 0;
         virtual void insert(Word word) = 0;
 
-        //Add word to the list of most frequent words
+        //Merge the term maps of a batch of documents, in parallel by partition
+        virtual void merge(std::vector<LocalIndex*>& locals, const std::vector<uint32_t>& documents);
+
+        //Update the list of most frequent words after a word's frequency grows
         virtual void addToFrequencyList(Word& word) = 0;
 
         //retrieving word from index - will not return void
         virtual Word& get(const std::__cxx11::string &word) = 0;
 
+        //collect pointers to every word in the index
+        virtual void getWords(std::vector<Word*>& words) = 0;
+
+        //Files a snapshot can read words from in place, and the words held
+        //in memory on top of them, which a snapshot copies
+        virtual void getFiles(std::vector<IndexFile>& files);
+        virtual void getUnsavedWords(std::vector<Word*>& words);
+        virtual const Word* findUnsaved(const std::string& word);
+
         //checks if index is empty
         virtual bool empty() = 0;
 
@@ -75,20 +105,53 @@ class IndexInterface
         //Print the list of most frequent words
         virtual void printFrequencyList() = 0;
 
-        //Calculate ranking of all elements in the index
-        virtual void recalculateRanking() = 0;
-
         //Get the data type of the index
         virtual std::string getDataType() = 0;
 
         //Get directory from the index file
         virtual std::string getDirectoryFromFile() = 0;
 
+        //Remove or replace a single document, leaving a tombstone in place of its postings
+        bool removeDocument(const std::string& file);
+        void updateDocument(const std::string& file);
+
+        //Remove the postings of every tombstone from the index
+        virtual void compact();
+
+        //Publish the current state of the index to readers, and get the last one published
+        void publish();
+        std::shared_ptr<const IndexSnapshot> getSnapshot() const;
+        bool isPublished() const { return snapshot != nullptr; }
+
+        //Give the index a new generation, so cached query results are no longer used
+        void bumpGeneration() { generation = ++generations; }
+        uint64_t getGeneration() const { return generation; }
+
+    protected:
+
+        //Rebuild the next published snapshot from every word
+        void markAllChanged() { allWordsChanged = true; bumpGeneration(); }
+
+        //Steps of merging a batch of term maps
+        void findWords(std::vector<LocalIndex*>& locals, std::vector<std::vector<Word*>>& targets);
+        static void mergePartitions(std::vector<LocalIndex*>& locals, const std::vector<uint32_t>& documents,
+                                    std::vector<std::vector<Word*>>& targets);
+
+    public:
+
 
         //Getters and setters
         std::string getIndexFile() const { return indexFile; }
+        void setIndexFile(const std::string& value) { indexFile = value; }
         std::string getIndexDirectory() const { return indexDirectory;}
         void setIndexDirectory(const std::string& value) { indexDirectory = value; }
-        std::vector<Word*> getFrequentWords() const { return frequentWords; }
-        std::string getWordCount() const { return wordCount; }
+        std::vector<Word*> getFrequentWords() const { return frequentWords.getWords(); }
+
+        //Rebuild the list of most frequent words after words have lost occurrences
+        void rebuildFrequencyList()
+        {
+            std::vector<Word*> words;
+            getWords(words);
+            frequentWords.rebuild(words);
+        }
 };
@@ -0,0 +1,283 @@
+#include <Index/indexsnapshot.h>
+#include <Index/indexinterface.h>
+#include <HashTable/hashtable.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+const int IndexSnapshot::NUM_SHARDS;
+const size_t IndexSnapshot::MAPPED_CAPACITY;
+
+/**
+ *
+ * shardOf(const std::string&)
+ *
+ * @param word  - the word to find the shard of
+ * @return      - the shard of the word, from 0 to NUM_SHARDS - 1
+ */
+int IndexSnapshot::shardOf(const std::string& word)
+{
+    return (HashTable::hash(word) >> 32) % NUM_SHARDS;
+}
+
+/**
+ *
+ * build(IndexInterface&, uint64_t)
+ *
+ * Builds a snapshot from a copy of every word of an index that is in any
+ * document, along with a copy of the Parser's counts and a copy of its
+ * DocumentTable, which shares the table's chunks of documents. If the
+ * index reads its words from files, only the words that aren't held by
+ * any file are copied, and the files are shared with the index.
+ * The index must not change while the snapshot is built, so it is only
+ * built by the thread that writes to the index.
+ *
+ * @param index     - the index to take the words from
+ * @param version   - the number of snapshots published before this one
+ * @return          - the new snapshot
+ */
+std::shared_ptr<const IndexSnapshot> IndexSnapshot::build(IndexInterface& index, uint64_t version)
+{
+    std::shared_ptr<IndexSnapshot> snapshot{new IndexSnapshot};
+    snapshot->version = version;
+
+    std::vector<IndexFile> files;
+    index.getFiles(files);
+    if(!files.empty())
+    {
+        snapshot->mapped = std::make_shared<MappedWords>();
+        snapshot->mapped->files = std::move(files);
+    }
+
+    std::vector<Word*> words;
+    index.getUnsavedWords(words);
+
+    std::vector<Shard> built(NUM_SHARDS);
+    for(Word* w : words)
+    {
+        if(w->getNumDocs() > 0)
+            built[shardOf(w->getWord())].push_back(std::make_shared<const Word>(*w));
+    }
+
+    for(int i{}; i < NUM_SHARDS; i++)
+    {
+        std::sort(built[i].begin(), built[i].end(),
+                  [](const std::shared_ptr<const Word>& lhs, const std::shared_ptr<const Word>& rhs)
+        {
+            return lhs->getWord() < rhs->getWord();
+        });
+        snapshot->shards[i] = std::make_shared<const Shard>(std::move(built[i]));
+    }
+
+    snapshot->documents = Parser::documents.share();
+    snapshot->numFiles = Parser::getNumFiles();
+    snapshot->numWords = Parser::getNumWords();
+    snapshot->generation = index.getGeneration();
+    return snapshot;
+}
+
+/**
+ *
+ * update(IndexInterface&, const std::unordered_set<std::string>&)
+ *
+ * Builds the next snapshot from this one. Only the shards holding a
+ * changed word are copied, and within them only the changed words are
+ * copied from the index; every other shard and word is shared with this
+ * snapshot. Words that are no longer in any document are left out. The
+ * counts are copied from the Parser, and the DocumentTable shares every
+ * chunk of documents the Parser's table hasn't changed since the last
+ * snapshot.
+ *
+ * The files the index reads from are shared, along with the words decoded
+ * from them, and only the part of a changed word that no file holds is
+ * copied. If the index reads from different files, such as after writing
+ * a segment or merging segments, the snapshot is built again.
+ *
+ * @param index     - the index to take the changed words from
+ * @param changed   - the words that have changed since this snapshot was built
+ * @return          - the new snapshot
+ */
+std::shared_ptr<const IndexSnapshot> IndexSnapshot::update(IndexInterface& index,
+                                                           const std::unordered_set<std::string>& changed) const
+{
+    std::vector<IndexFile> files;
+    index.getFiles(files);
+    if(!hasFiles(files))
+        return build(index, version + 1);
+
+    std::shared_ptr<IndexSnapshot> snapshot{new IndexSnapshot(*this)};
+    snapshot->version = version + 1;
+
+    std::vector<std::vector<std::string>> changedShards(NUM_SHARDS);
+    for(const std::string& word : changed)
+        changedShards[shardOf(word)].push_back(word);
+
+    for(int i{}; i < NUM_SHARDS; i++)
+    {
+        std::vector<std::string>& names = changedShards[i];
+        if(names.empty())
+            continue;
+        std::sort(names.begin(), names.end());
+
+        //Merge the changed words into the sorted words of the shard
+        const Shard& old = *shards[i];
+        Shard merged;
+        merged.reserve(old.size() + names.size());
+        size_t o{};
+        for(const std::string& name : names)
+        {
+            for(; o < old.size() && old[o]->getWord() < name; o++)
+                merged.push_back(old[o]);
+            if(o < old.size() && old[o]->getWord() == name)
+                o++;
+
+            const Word* current = index.findUnsaved(name);
+            if(current != nullptr && current->getNumDocs() > 0)
+                merged.push_back(std::make_shared<const Word>(*current));
+        }
+        merged.insert(merged.end(), old.begin() + o, old.end());
+
+        snapshot->shards[i] = std::make_shared<const Shard>(std::move(merged));
+    }
+
+    snapshot->documents = Parser::documents.share();
+    snapshot->numFiles = Parser::getNumFiles();
+    snapshot->numWords = Parser::getNumWords();
+    snapshot->generation = index.getGeneration();
+    return snapshot;
+}
+
+/**
+ *
+ * hasFiles(const std::vector<IndexFile>&)
+ *
+ * @param files - the files an index reads its words from
+ * @return      - true if this snapshot reads the same opened files, in the
+ *                same order, false if not
+ */
+bool IndexSnapshot::hasFiles(const std::vector<IndexFile>& files) const
+{
+    if(mapped == nullptr)
+        return files.empty();
+    if(mapped->files.size() != files.size())
+        return false;
+
+    for(size_t i{}; i < files.size(); i++)
+    {
+        if(!mapped->files[i].sharesMapping(files[i]))
+            return false;
+    }
+    return true;
+}
+
+/**
+ *
+ * find(const std::string&)
+ *
+ * Finds a word by binary search within its shard. If the snapshot reads
+ * files, the part of the word they hold is merged with it.
+ *
+ * @param word  - the word to search for
+ * @return      - the Word, which the caller keeps for as long as it uses
+ *                it, or nullptr if it isn't in the snapshot
+ */
+std::shared_ptr<const Word> IndexSnapshot::find(const std::string& word) const
+{
+    const Shard& shard = *shards[shardOf(word)];
+    auto it = std::lower_bound(shard.begin(), shard.end(), word,
+                               [](const std::shared_ptr<const Word>& lhs, const std::string& rhs)
+    {
+        return lhs->getWord() < rhs;
+    });
+    std::shared_ptr<const Word> unsaved;
+    if(it != shard.end() && (*it)->getWord() == word)
+        unsaved = *it;
+
+    if(mapped == nullptr)
+        return unsaved;
+
+    std::shared_ptr<const Word> saved{readMapped(word)};
+    if(saved == nullptr || unsaved == nullptr)
+        return (saved == nullptr) ? unsaved : saved;
+
+    std::shared_ptr<Word> merged = std::make_shared<Word>(*saved);
+    merged->merge(*unsaved);
+    return merged;
+}
+
+/**
+ *
+ * readMapped(const std::string&)
+ *
+ * Finds a word among the words decoded from the files, or decodes it from
+ * every file that holds it and merges the parts, as MappedIndex does. The
+ * least recently used words are let go once the decoded words hold more
+ * than MAPPED_CAPACITY postings; readers that still hold them keep them.
+ *
+ * @param word  - the word to search for
+ * @return      - the Word, or nullptr if no file holds it
+ */
+std::shared_ptr<const Word> IndexSnapshot::readMapped(const std::string& word) const
+{
+    {
+        std::lock_guard<std::mutex> guard(mapped->lock);
+        auto it = mapped->entries.find(word);
+        if(it != mapped->entries.end())
+        {
+            mapped->recent.splice(mapped->recent.begin(), mapped->recent, it->second);
+            return *it->second;
+        }
+    }
+
+    Word result;
+    bool found{false};
+    for(const IndexFile& file : mapped->files)
+    {
+        int term = file.findTerm(word);
+        if(term < 0)
+            continue;
+
+        if(found)
+            result.merge(file.getWord(term));
+        else
+            result = file.getWord(term);
+        found = true;
+    }
+    if(!found)
+        return nullptr;
+
+    std::shared_ptr<const Word> decoded = std::make_shared<const Word>(std::move(result));
+
+    //Another reader may have decoded the word at the same time
+    std::lock_guard<std::mutex> guard(mapped->lock);
+    auto it = mapped->entries.find(word);
+    if(it != mapped->entries.end())
+        return *it->second;
+
+    mapped->recent.push_front(decoded);
+    mapped->entries[word] = mapped->recent.begin();
+    mapped->numPostings += decoded->getNumDocs();
+    while(mapped->numPostings > MAPPED_CAPACITY && mapped->recent.size() > 1)
+    {
+        mapped->numPostings -= mapped->recent.back()->getNumDocs();
+        mapped->entries.erase(mapped->recent.back()->getWord());
+        mapped->recent.pop_back();
+    }
+    return decoded;
+}
+
+/**
+ *
+ * getTopDocs(const Word&, int)
+ *
+ * Ranks the documents of a result found within the snapshot against the
+ * counts of the snapshot, rather than the Parser's current counts.
+ *
+ * @param result    - a Word found within, or built by a query on, the snapshot
+ * @param k         - the number of documents to return
+ * @return          - the k highest ranked documents
+ */
+std::vector<DocDetails> IndexSnapshot::getTopDocs(const Word& result, int k) const
+{
+    return result.getTopDocs(k, *documents, numFiles);
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+
+#include <Word/word.h>
+#include <Parser/documenttable.h>
+#include <Index/indexfile.h>
+
+class IndexInterface;
+
+/**
+ * The IndexSnapshot class is an immutable, read-only view of an index as it
+ * was when the view was published. A snapshot holds its own copies of the
+ * words and a read-only copy of the DocumentTable, so any number of threads
+ * can search it at once, while the index itself keeps changing.
+ *
+ * Readers get the current snapshot from IndexInterface::getSnapshot() and
+ * keep it for as long as a query needs it. Once every reader has let go of
+ * an old snapshot, it is freed. The writer publishes a new snapshot with
+ * IndexInterface::publish(), which never waits for readers.
+ *
+ * The words are split into NUM_SHARDS shards by the hash of the word, each
+ * a sorted list of shared, immutable Words. A new snapshot shares every
+ * shard and Word that hasn't changed with the one before it, and the
+ * DocumentTable shares every chunk of documents that hasn't changed, so
+ * publishing after a batch of documents only copies the shards, words, and
+ * chunks of documents the batch touched, along with the tombstones.
+ *
+ * The words of a MappedIndex or SegmentedIndex are held by files that never
+ * change, so a snapshot of one only copies the words of the buffer, and
+ * shares the mappings of the files with the index. Their words are decoded
+ * the first time they are searched for, into a cache bounded by its number
+ * of postings, which is shared by every snapshot of the same files. The
+ * cache is locked only to find and add words, never while decoding them.
+ *
+ * By: Oisin Coveney
+ */
+class IndexSnapshot
+{
+    public:
+
+        //Number of shards the words are split into
+        static const int NUM_SHARDS = 256;
+
+        //Number of postings of the words decoded from files that are kept
+        static const size_t MAPPED_CAPACITY = 1 << 22;
+
+    private:
+
+        //Words decoded from the files of an index, most recently used first
+        struct MappedWords
+        {
+            std::vector<IndexFile> files;
+            std::mutex lock;
+            std::list<std::shared_ptr<const Word>> recent;
+            std::unordered_map<std::string, std::list<std::shared_ptr<const Word>>::iterator> entries;
+            size_t numPostings{0};
+        };
+        std::shared_ptr<MappedWords> mapped;
+
+        //Words of a shard, sorted alphabetically
+        typedef std::vector<std::shared_ptr<const Word>> Shard;
+        std::vector<std::shared_ptr<const Shard>> shards;
+
+        //Documents of the index, and the counts the rankings are calculated from
+        std::shared_ptr<const DocumentTable> documents;
+        int numFiles;
+        int numWords;
+
+        //Number of snapshots published before this one, and the generation of the index it was built from
+        uint64_t version;
+        uint64_t generation;
+
+        //Shard a word belongs to
+        static int shardOf(const std::string& word);
+
+        //Decode a word from the files, or nullptr if no file holds it
+        std::shared_ptr<const Word> readMapped(const std::string& word) const;
+
+        //Check that the snapshot reads the same files
+        bool hasFiles(const std::vector<IndexFile>& files) const;
+
+        //Constructor
+        IndexSnapshot() : mapped{}, shards(NUM_SHARDS), documents{}, numFiles{0},
+                          numWords{0}, version{0}, generation{0} {}
+
+    public:
+
+        //Build a snapshot from every word of an index
+        static std::shared_ptr<const IndexSnapshot> build(IndexInterface& index, uint64_t version);
+
+        //Build a snapshot from this one, taking the changed words from the index
+        std::shared_ptr<const IndexSnapshot> update(IndexInterface& index,
+                                                    const std::unordered_set<std::string>& changed) const;
+
+        //Find a word, or nullptr if it isn't in the snapshot
+        std::shared_ptr<const Word> find(const std::string& word) const;
+
+        //Rank a result of the snapshot
+        std::vector<DocDetails> getTopDocs(const Word& result, int k) const;
+
+        //Getters
+        const DocumentTable& getDocuments() const { return *documents; }
+        int getNumFiles() const { return numFiles; }
+        int getNumWords() const { return numWords; }
+        uint64_t getVersion() const { return version; }
+        uint64_t getGeneration() const { return generation; }
+};
@@ -0,0 +1,86 @@
+#include <Index/localindex.h>
+#include <HashTable/hashtable.h>
+
+const int LocalIndex::NUM_PARTITIONS;
+
+/**
+ *
+ * add(const std::string&)
+ *
+ * Counts an occurrence of a word. A word that hasn't been seen in the
+ * document yet is added after every other term.
+ *
+ * @param word  - the word to count
+ */
+void LocalIndex::add(const std::string& word)
+{
+    numWords++;
+
+    auto it = positions.find(word);
+    if(it != positions.end())
+    {
+        terms[it->second].frequency++;
+        return;
+    }
+
+    positions.emplace(word, terms.size());
+    terms.push_back(Term{word, 1});
+}
+
+/**
+ *
+ * add(const std::vector<std::string>&)
+ *
+ * Counts an occurrence of every word of a list, in order.
+ *
+ * @param words - the words to count
+ */
+void LocalIndex::add(const std::vector<std::string>& words)
+{
+    for(const std::string& word : words)
+        add(word);
+}
+
+/**
+ *
+ * partition()
+ *
+ * Splits the terms into partitions by the hash of their words, keeping the
+ * order they first appear in within each partition. The positions of the
+ * words are no longer needed, so they are freed.
+ */
+void LocalIndex::partition()
+{
+    partitions.assign(NUM_PARTITIONS, std::vector<uint32_t>{});
+    for(uint32_t i{}; i < terms.size(); i++)
+        partitions[partitionOf(terms[i].word)].push_back(i);
+
+    std::unordered_map<std::string, uint32_t>{}.swap(positions);
+}
+
+/**
+ *
+ * partitionOf(const std::string&)
+ *
+ * Uses the upper half of the word's hash, since the hash table uses the
+ * lower bits to place the word.
+ *
+ * @param word  - the word to find the partition of
+ * @return      - the partition of the word, from 0 to NUM_PARTITIONS - 1
+ */
+int LocalIndex::partitionOf(const std::string& word)
+{
+    return (HashTable::hash(word) >> 32) % NUM_PARTITIONS;
+}
+
+/**
+ * clear()
+ * Removes every term and partition
+ */
+void LocalIndex::clear()
+{
+    terms.clear();
+    positions.clear();
+    partitions.clear();
+    numWords = 0;
+}
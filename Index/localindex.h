@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * The LocalIndex class is a private term map of a single document, or a
+ * part of one, built by the worker thread that parsed it. Every word is
+ * counted once per document instead of being inserted into the shared
+ * index once per occurrence, and the terms are kept in the order they
+ * first appear, so the index built from them is the same as one built a
+ * word at a time.
+ *
+ * Once the document has been read, the terms are split into NUM_PARTITIONS
+ * partitions by the hash of the word. A word is in the same partition in
+ * every document, so the partitions of a batch of documents can be merged
+ * into the index by separate threads without sharing a single Word.
+ *
+ * By: Oisin Coveney
+ */
+class LocalIndex
+{
+    public:
+
+        //Number of partitions the terms are split into
+        static const int NUM_PARTITIONS = 64;
+
+        //A word and the number of times it occurs in the document
+        struct Term
+        {
+            std::string word;
+            uint32_t frequency;
+        };
+
+    private:
+
+        //Terms in the order they first appear, and the position of each
+        std::vector<Term> terms;
+        std::unordered_map<std::string, uint32_t> positions;
+
+        //Positions of the terms within each partition
+        std::vector<std::vector<uint32_t>> partitions;
+
+        //Number of words counted, including repeats
+        size_t numWords;
+
+    public:
+
+        //Constructor
+        LocalIndex() : terms{}, positions{}, partitions{}, numWords{0} {}
+
+        //Count an occurrence of a word, or of every word of a list
+        void add(const std::string& word);
+        void add(const std::vector<std::string>& words);
+
+        //Split the terms into partitions once every word has been counted
+        void partition();
+
+        //Partition a word belongs to
+        static int partitionOf(const std::string& word);
+
+        //Remove every term
+        void clear();
+
+        //Getters
+        std::vector<Term>& getTerms() { return terms; }
+        const std::vector<uint32_t>& getPartition(int partition) const { return partitions[partition]; }
+        bool isPartitioned() const { return !partitions.empty(); }
+        size_t getNumWords() const { return numWords; }
+};
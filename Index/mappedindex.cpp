@@ -0,0 +1,302 @@
+#include <Index/mappedindex.h>
+
+#include <unordered_set>
+
+/**
+ * insert(std::string)
+ *
+ * @exception   - logic_error, since the index is read-only
+ */
+Word& MappedIndex::insert(std::string&)
+{
+    throw std::logic_error("Words cannot be inserted into a mapped index.");
+}
+
+/**
+ * insert(std::string, uint32_t)
+ *
+ * @exception   - logic_error, since the index is read-only
+ */
+void MappedIndex::insert(std::string&, uint32_t)
+{
+    throw std::logic_error("Words cannot be inserted into a mapped index.");
+}
+
+/**
+ * insert(Word)
+ *
+ * @exception   - logic_error, since the index is read-only
+ */
+void MappedIndex::insert(Word)
+{
+    throw std::logic_error("Words cannot be inserted into a mapped index.");
+}
+
+/**
+ * addToFrequencyList(Word&)
+ *
+ * The most frequent words are read from the index file, so nothing happens.
+ */
+void MappedIndex::addToFrequencyList(Word&) {}
+
+/**
+ * empty()
+ * @return  - true if no index file is loaded, false if not
+ */
+bool MappedIndex::empty()
+{
+    return !file.isOpen();
+}
+
+/**
+ *
+ * readWord(const std::string&, Word&)
+ *
+ * Finds a word in the term dictionary of the index file and of every
+ * segment, and merges what each file holds into a single Word.
+ *
+ * @param word      - the word to search for
+ * @param result    - the Word to place the merged postings into
+ * @return          - true if any file holds the word, false if not
+ */
+bool MappedIndex::readWord(const std::string& word, Word& result)
+{
+    bool found{false};
+    if(file.isOpen())
+    {
+        int term = file.findTerm(word);
+        if(term >= 0)
+        {
+            result = file.getWord(term);
+            found = true;
+        }
+    }
+
+    for(IndexFile* segment : segments)
+    {
+        int term = segment->findTerm(word);
+        if(term < 0)
+            continue;
+
+        if(found)
+            result.merge(segment->getWord(term));
+        else
+            result = segment->getWord(term);
+        found = true;
+    }
+    return found;
+}
+
+/**
+ *
+ * get(std::string)
+ *
+ * Returns a reference to the word within the index. The first time a word
+ * is requested, it is found in the term dictionaries of the index file and
+ * its segments and decoded; later requests return the decoded word.
+ *
+ * @param word  - the word to search for
+ * @exception   - out_of_range if the word isn't found
+ * @return      - a reference to the Word object
+ */
+Word& MappedIndex::get(const std::string& word)
+{
+    Word* cached = words.find(word);
+    if(cached != nullptr)
+        return *cached;
+
+    Word result;
+    if(!readWord(word, result))
+        throw std::out_of_range("The element does not exist in the index");
+
+    return words.insert(result);
+}
+
+/**
+ *
+ * getWords(std::vector<Word*>&)
+ *
+ * Decodes every word within the index file and its segments and adds a
+ * pointer to each to the vector. The words are pinned in the cache, so the
+ * pointers stay valid until the index is cleared.
+ *
+ * @param all   - the vector to add the words to
+ */
+void MappedIndex::getWords(std::vector<Word*>& all)
+{
+    std::vector<IndexFile*> files{segments};
+    if(file.isOpen())
+        files.insert(files.begin(), &file);
+
+    //Words held by more than one file are only added once
+    std::unordered_set<std::string> added;
+    for(IndexFile* f : files)
+    {
+        for(int i{}; i < f->getNumTerms(); i++)
+        {
+            std::string term = f->getTerm(i);
+            if(added.insert(term).second)
+            {
+                get(term);
+                all.push_back(&words.pin(term));
+            }
+        }
+    }
+}
+
+/**
+ *
+ * getFiles(std::vector<IndexFile>&)
+ *
+ * Adds copies of the index file and every segment, in the order their
+ * parts of a word are merged. The copies share the mappings of the index,
+ * so they stay readable after the index has closed them.
+ *
+ * @param files - the vector to add the files to
+ */
+void MappedIndex::getFiles(std::vector<IndexFile>& files)
+{
+    if(file.isOpen())
+        files.push_back(file);
+    for(IndexFile* segment : segments)
+        files.push_back(*segment);
+}
+
+/**
+ * getUnsavedWords(std::vector<Word*>&)
+ *
+ * Every word is held by the files, so no words are added.
+ */
+void MappedIndex::getUnsavedWords(std::vector<Word*>&) {}
+
+/**
+ * findUnsaved(const std::string&)
+ *
+ * @return  - nullptr, since every word is held by the files
+ */
+const Word* MappedIndex::findUnsaved(const std::string&)
+{
+    return nullptr;
+}
+
+/**
+ *
+ * load()
+ *
+ * Maps the index file and reads the corpus counts, the table of documents,
+ * and the names and frequencies of the most frequent words. No words are
+ * decoded.
+ *
+ * @return  - false if the index file is invalid, true otherwise
+ */
+bool MappedIndex::load()
+{
+    clear();
+    if(!file.open(getIndexFile()))
+        return false;
+
+    indexDirectory = file.getDirectory();
+    Parser::numFiles = file.getNumFiles();
+    Parser::numPages = file.getNumPages();
+    Parser::numWords = file.getNumWords();
+
+    //Get the document table, so document IDs match the postings
+    file.readDocuments(Parser::documents);
+
+    //Map the segments
+    for(const std::string& path : file.getSegments())
+    {
+        IndexFile* segment = new IndexFile();
+        if(!segment->open(path))
+        {
+            delete segment;
+            clear();
+            return false;
+        }
+        segments.push_back(segment);
+    }
+
+    //Get most frequent words and their frequencies
+    for(const Word& word : file.getFrequentSummary())
+    {
+        frequentSummary.push_back(word);
+        frequentWords.update(frequentSummary.back());
+    }
+    return true;
+}
+
+/**
+ * closeSegments()
+ *
+ * Unmaps and deletes every segment file
+ */
+void MappedIndex::closeSegments()
+{
+    for(IndexFile* segment : segments)
+        delete segment;
+    segments.clear();
+}
+
+/**
+ *
+ * clear()
+ *
+ * Unmaps the index file and its segments, and clears the decoded words
+ */
+void MappedIndex::clear()
+{
+    frequentWords.clear();
+    frequentSummary.clear();
+    words.clear();
+    closeSegments();
+    file.close();
+    markAllChanged();
+}
+
+/**
+ * printToFile()
+ *
+ * The index is read from the index file and cannot change, so nothing
+ * needs to be written.
+ */
+void MappedIndex::printToFile() {}
+
+/**
+ * Destructor
+ */
+MappedIndex::~MappedIndex()
+{
+    closeSegments();
+}
+
+/**
+ * printFrequencyList()
+ *
+ * Uses std::cout to output the list of 50 most frequent words
+ */
+void MappedIndex::printFrequencyList()
+{
+    for(Word* w : getFrequentWords())
+        std::cout << w->getWord() << "\t" << w->getTotalFrequency() << " times" << std::endl;
+}
+
+/**
+ * getDataType()
+ *
+ * @return  - a string containing "mapped file"
+ */
+std::string MappedIndex::getDataType()
+{
+    return "mapped file";
+}
+
+/**
+ * getDirectoryFromFile()
+ *
+ * @return  - a string containing the directory from the index file if it exists
+ */
+std::string MappedIndex::getDirectoryFromFile()
+{
+    IndexFile other;
+    return other.open(getIndexFile()) ? other.getDirectory() : "";
+}
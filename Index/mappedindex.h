@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdexcept>
+#include <deque>
+
+#include <Index/indexinterface.h>
+#include <Index/indexfile.h>
+#include <Index/wordcache.h>
+
+/**
+ *
+ * MappedIndex is a read-only subclass of IndexInterface that searches the
+ * persistent index file in place. The file is mapped into memory by an
+ * IndexFile, and a word is only decoded the first time it is requested,
+ * so loading takes the same time no matter how large the index is. If the
+ * index file lists segments, each is mapped as well, and a word is decoded
+ * from every file that holds it and merged.
+ *
+ * Decoded words are kept in a WordCache bounded by their number of
+ * postings, so searching a large index for a long time doesn't decode the
+ * whole file into memory. A reference returned by get() is only valid
+ * until the next call to get(). The words collected by getWords() are
+ * pinned, and stay valid until the index is cleared. The list of most
+ * frequent words is read from the summary in the index file, so loading
+ * doesn't decode their postings, which are the longest in the index.
+ *
+ * Words cannot be inserted into a MappedIndex; build or update the index
+ * with a HashIndex or AVLIndex and save it with printToFile().
+ *
+ * By: Oisin Coveney
+ *
+ */
+class MappedIndex : public IndexInterface
+{
+    protected:
+
+        IndexFile file;
+
+        //Segment files listed by the index file
+        std::vector<IndexFile*> segments;
+
+        //Words that have been decoded from the files
+        WordCache words;
+
+        //Names and total frequencies of the most frequent words, without postings
+        std::deque<Word> frequentSummary;
+
+        //Decode a word from the index file and every segment
+        bool readWord(const std::string& word, Word& result);
+
+        //Unmap the segment files
+        void closeSegments();
+
+    public:
+
+        //Constructor
+        MappedIndex() : file{}, segments{}, words{}, frequentSummary{} {}
+
+        //Insertion is not supported, and throws a logic_error
+        Word& insert(std::string& word) override;
+        void insert(std::string& word, uint32_t document) override;
+        void insert(Word word) override;
+        void addToFrequencyList(Word& word) override;
+
+        //Check if empty
+        bool empty() override;
+
+        //Return element
+        Word& get(const std::string& word) override;
+
+        //Collect every word in the index
+        void getWords(std::vector<Word*>& all) override;
+
+        //Snapshots read the words of the files in place
+        void getFiles(std::vector<IndexFile>& files) override;
+        void getUnsavedWords(std::vector<Word*>& all) override;
+        const Word* findUnsaved(const std::string& word) override;
+
+        //Load the index file, and close it
+        bool load() override;
+        void clear() override;
+
+        //The index file is already up to date
+        void printToFile() override;
+
+        //Destructor
+        ~MappedIndex();
+
+        //Frequency list
+        void printFrequencyList() override;
+
+        //Returns "mapped file"
+        std::string getDataType() override;
+
+        //get directory from file
+        std::string getDirectoryFromFile() override;
+};
@@ -0,0 +1,735 @@
+#include <Index/segmentedindex.h>
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <queue>
+#include <unordered_set>
+#include <experimental/filesystem>
+
+const int SegmentedIndex::BUFFER_WORDS;
+const int SegmentedIndex::MERGE_FACTOR;
+const size_t SegmentedIndex::MIN_TIER_SIZE;
+
+/**
+ * empty()
+ * @return  - true if nothing has been loaded or inserted, false if not
+ */
+bool SegmentedIndex::empty()
+{
+    return isEmpty;
+}
+
+/**
+ *
+ * insert(std::string)
+ *
+ * Inserts the word into the buffer. The word decoded from the segments no
+ * longer matches the index, so it is forgotten. The list of most frequent
+ * words is found again when the index is saved.
+ *
+ * @param word  - the word to add to the index
+ * @return      - a reference to the Word object within the buffer
+ */
+Word& SegmentedIndex::insert(std::string& word)
+{
+    isEmpty = false;
+    if(!words.empty())
+        words.invalidate(word);
+    return buffer.insert(word);
+}
+
+/**
+ *
+ * insert(std::string, uint32_t)
+ *
+ * Adds the document ID to the word within the buffer, and writes the
+ * buffer as a new segment once it is full.
+ *
+ * @param word      - the word to add to the index and add a document to
+ * @param document  - the ID of the document to add to the Word object
+ */
+void SegmentedIndex::insert(std::string& word, uint32_t document)
+{
+    insert(word).addDoc(document);
+
+    if(++bufferedWords >= BUFFER_WORDS)
+        flush();
+}
+
+/**
+ *
+ * insert(Word)
+ *
+ * Inserts the word into the buffer. A word that is already in the buffer
+ * gains the documents of the new one.
+ *
+ * @param word  - the word to insert into the index
+ */
+void SegmentedIndex::insert(Word word)
+{
+    std::string key{word.getWord()};
+    int size = buffer.getSize();
+    Word& inserted = insert(key);
+    if(buffer.getSize() == size)
+        inserted.merge(word);
+    else
+        inserted = word;
+
+    bufferedWords += word.getNumDocs();
+    if(bufferedWords >= BUFFER_WORDS)
+        flush();
+}
+
+/**
+ *
+ * merge(std::vector<LocalIndex*>&, const std::vector<uint32_t>&)
+ *
+ * Merges the term maps of a batch of documents into the buffer, in
+ * parallel by partition, and writes the buffer as a new segment once it
+ * is full. The most frequent words are found when the index is saved, so
+ * the list isn't updated.
+ *
+ * @param locals    - the term map of each document
+ * @param documents - the ID of each document
+ */
+void SegmentedIndex::merge(std::vector<LocalIndex*>& locals, const std::vector<uint32_t>& documents)
+{
+    std::vector<std::vector<Word*>> targets;
+    findWords(locals, targets);
+    mergePartitions(locals, documents, targets);
+
+    for(LocalIndex* local : locals)
+        bufferedWords += local->getNumWords();
+    if(bufferedWords >= BUFFER_WORDS)
+        flush();
+}
+
+/**
+ * addToFrequencyList(Word&)
+ *
+ * The most frequent words are found when the index is saved, so nothing
+ * happens.
+ */
+void SegmentedIndex::addToFrequencyList(Word&) {}
+
+/**
+ *
+ * get(std::string)
+ *
+ * Returns a reference to the word within the index. The first time a word
+ * is requested, its parts are decoded from the index file and every
+ * segment, and merged with its part in the buffer; later requests return
+ * the merged word.
+ *
+ * @param word  - the word to search for
+ * @exception   - out_of_range if the word isn't found
+ * @return      - a reference to the Word object
+ */
+Word& SegmentedIndex::get(const std::string& word)
+{
+    Word* cached = words.find(word);
+    if(cached != nullptr)
+        return *cached;
+
+    Word result;
+    bool found = readWord(word, result);
+    try
+    {
+        Word& buffered = buffer.getWord(word);
+        if(found)
+            result.merge(buffered);
+        else
+            result = buffered;
+        found = true;
+    }
+    catch(std::out_of_range&) {}
+
+    if(!found)
+        throw std::out_of_range("The element does not exist in the index");
+
+    return words.insert(result);
+}
+
+/**
+ *
+ * getWords(std::vector<Word*>&)
+ *
+ * Decodes every word within the index file, its segments, and the buffer,
+ * and adds a pointer to each to the vector.
+ *
+ * @param all   - the vector to add the words to
+ */
+void SegmentedIndex::getWords(std::vector<Word*>& all)
+{
+    size_t first = all.size();
+    MappedIndex::getWords(all);
+
+    //Words held by a file as well as the buffer have been added
+    std::unordered_set<std::string> added;
+    for(size_t i{first}; i < all.size(); i++)
+        added.insert(all[i]->getWord());
+
+    for(int i{}; i < buffer.getSize(); i++)
+    {
+        const std::string& word = buffer[i].getWord();
+        if(added.count(word) == 0)
+        {
+            get(word);
+            all.push_back(&words.pin(word));
+        }
+    }
+}
+
+/**
+ *
+ * getUnsavedWords(std::vector<Word*>&)
+ *
+ * Adds a pointer to every word of the buffer, which no segment holds yet.
+ *
+ * @param all   - the vector to add the words to
+ */
+void SegmentedIndex::getUnsavedWords(std::vector<Word*>& all)
+{
+    for(int i{}; i < buffer.getSize(); i++)
+        all.push_back(&buffer[i]);
+}
+
+/**
+ *
+ * findUnsaved(const std::string&)
+ *
+ * @param word  - the word to search for
+ * @return      - the part of the word within the buffer, or nullptr if the
+ *                buffer doesn't hold it
+ */
+const Word* SegmentedIndex::findUnsaved(const std::string& word)
+{
+    try
+    {
+        return &buffer.getWord(word);
+    }
+    catch(std::out_of_range&)
+    {
+        return nullptr;
+    }
+}
+
+/**
+ *
+ * load()
+ *
+ * Maps the index file and its segments, and reads the corpus counts, the
+ * table of documents, and the most frequent words. No other words are
+ * decoded.
+ *
+ * @return  - false if the index file or a segment is invalid, true otherwise
+ */
+bool SegmentedIndex::load()
+{
+    if(!MappedIndex::load())
+        return false;
+
+    isEmpty = false;
+    return true;
+}
+
+/**
+ *
+ * clear()
+ *
+ * Waits for a running merge, then unmaps the index file and its segments
+ * and clears the buffer. Segments written since the last save are left on
+ * disk, but aren't listed by the index file.
+ */
+void SegmentedIndex::clear()
+{
+    waitForMerge();
+
+    isEmpty = true;
+    buffer.clear();
+    bufferedWords = 0;
+    MappedIndex::clear();
+}
+
+/**
+ *
+ * printToFile()
+ *
+ * Saves the index. The buffer is written as a new segment, and the index
+ * file is rewritten as a manifest listing every segment along with the
+ * document table and the most frequent words. A merge that has finished
+ * is swapped in first. Then a compaction that was waiting for it is
+ * started, or a new merge if a tier is full.
+ */
+void SegmentedIndex::printToFile()
+{
+    flush();
+    adoptIndexFile();
+
+    //The merge thread rewrites the index file, so it must not do so at the same time
+    std::unique_lock<std::mutex> lock(mergeLock);
+    if(mergeDone)
+    {
+        merger.join();
+        installMerge();
+    }
+
+    findFrequentWords();
+
+    std::vector<std::string> segmentFiles;
+    for(IndexFile* segment : segments)
+        segmentFiles.push_back(segment->getPath());
+    IndexFile::writeManifest(getIndexFile(), *this, segmentFiles, getFrequentWords());
+    lock.unlock();
+
+    if(compactPending)
+        compact();
+    else
+        startMerge();
+}
+
+/**
+ *
+ * compact()
+ *
+ * Starts merging every segment listed by the index file into one on the
+ * merge thread, dropping the postings of the tombstones, so removing a
+ * document never waits for the whole index to be rewritten. The tombstones
+ * are left out of search results until the merged segment is swapped in,
+ * when they are forgotten.
+ *
+ * Segments written since the last save aren't listed yet, so the merged
+ * segment couldn't take their place in the index file. They only hold
+ * documents added since then, which have higher IDs than any document the
+ * index file holds, as a document that is parsed again gets a new ID. Only
+ * the tombstones of documents the index file holds are dropped, and the
+ * rest are compacted after the next save, as is everything if a merge is
+ * running.
+ */
+void SegmentedIndex::compact()
+{
+    if(merger.joinable())
+    {
+        std::unique_lock<std::mutex> lock(mergeLock);
+        if(!mergeDone)
+        {
+            //Even a running compaction misses documents removed since it started
+            compactPending = true;
+            return;
+        }
+        lock.unlock();
+        waitForMerge();
+    }
+
+    const PostingList& tombstones = Parser::documents.getTombstones();
+    IndexFile manifest;
+    if(tombstones.empty() || !manifest.open(getIndexFile()))
+    {
+        compactPending = !tombstones.empty();
+        return;
+    }
+
+    std::vector<std::string> listed;
+    for(const std::string& path : manifest.getSegments())
+        listed.push_back(std::experimental::filesystem::path(path).filename());
+
+    std::vector<std::string> inputs;
+    for(IndexFile* segment : segments)
+    {
+        std::string name = std::experimental::filesystem::path(segment->getPath()).filename();
+        if(std::find(listed.begin(), listed.end(), name) != listed.end())
+            inputs.push_back(segment->getPath());
+    }
+
+    PostingList dropped;
+    uint32_t numDocuments = (uint32_t) manifest.getNumDocuments();
+    for(PostingList::Cursor c{tombstones}; c.valid() && c.id() < numDocuments; c.next())
+        dropped.append(c.id(), c.frequency());
+
+    compactPending = dropped.size() < tombstones.size();
+    if(dropped.empty() || inputs.empty())
+        return;
+
+    runMerge(inputs, dropped, true);
+}
+
+/**
+ * Destructor
+ *
+ * Waits for a running merge, which records itself in the index file.
+ */
+SegmentedIndex::~SegmentedIndex()
+{
+    waitForMerge();
+}
+
+/**
+ * getDataType()
+ *
+ * @return  - a string containing "segments"
+ */
+std::string SegmentedIndex::getDataType()
+{
+    return "segments";
+}
+
+/**
+ *
+ * flush()
+ *
+ * Writes the words of the buffer as a new segment, maps it, and clears the
+ * buffer. Words that were decoded before stay the same, since the segment
+ * holds the same postings as the buffer did.
+ *
+ * @return  - true if the buffer was empty or written, false if not
+ */
+bool SegmentedIndex::flush()
+{
+    if(buffer.getSize() == 0)
+        return true;
+
+    std::vector<Word*> list;
+    for(int i{}; i < buffer.getSize(); i++)
+        list.push_back(&buffer[i]);
+
+    std::string path = newSegmentFile();
+    IndexFile* segment = new IndexFile();
+    if(!IndexFile::writeSegment(path, list, Parser::documents.size()) || !segment->open(path))
+    {
+        delete segment;
+        std::remove(path.c_str());
+        return false;
+    }
+
+    segments.push_back(segment);
+    buffer.clear();
+    bufferedWords = 0;
+    return true;
+}
+
+/**
+ *
+ * newSegmentFile()
+ *
+ * Names a new segment after the index file and a number. Numbers are not
+ * reused while the index is open, and files that already exist are
+ * skipped.
+ *
+ * @return  - the path of the new segment
+ */
+std::string SegmentedIndex::newSegmentFile()
+{
+    std::string path;
+    do
+    {
+        path = getIndexFile() + "." + std::to_string(nextSegment++) + ".seg";
+    }
+    while(std::experimental::filesystem::exists(path));
+    return path;
+}
+
+/**
+ *
+ * adoptIndexFile()
+ *
+ * An index file written by a HashIndex or AVLIndex holds words of its own.
+ * Before it is replaced by a manifest, it is linked under the name of a new
+ * segment, so its words become the oldest segment and the index file
+ * itself is never missing.
+ */
+void SegmentedIndex::adoptIndexFile()
+{
+    namespace fs = std::experimental::filesystem;
+
+    if(!file.isOpen() || file.getNumTerms() == 0)
+        return;
+
+    std::string path = newSegmentFile();
+    std::error_code error;
+    fs::create_hard_link(file.getPath(), path, error);
+    if(error && !fs::copy_file(file.getPath(), path, error))
+        return;
+
+    IndexFile* segment = new IndexFile();
+    if(!segment->open(path))
+    {
+        delete segment;
+        return;
+    }
+
+    segments.insert(segments.begin(), segment);
+    file.close();
+}
+
+/**
+ *
+ * findFrequentWords()
+ *
+ * Finds the most frequent words by merging the term dictionaries of the
+ * index file and every segment, adding up the frequency of each word from
+ * its term entries, so no postings are decoded. The buffer is written
+ * before this is called, so every word is in a file.
+ */
+void SegmentedIndex::findFrequentWords()
+{
+    std::vector<IndexFile*> files{segments};
+    if(file.isOpen())
+        files.insert(files.begin(), &file);
+
+    //Min-heap of the most frequent words, ranked as the FrequencyList ranks them
+    typedef std::pair<int, std::string> Candidate;
+    auto moreFrequent = [](const Candidate& lhs, const Candidate& rhs)
+    {
+        return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(moreFrequent)> top(moreFrequent);
+
+    mergeTerms(files, [&top, &moreFrequent](const std::string& term,
+                                            std::vector<std::pair<IndexFile*, int>>& holders)
+    {
+        Candidate candidate{0, term};
+        for(std::pair<IndexFile*, int>& h : holders)
+            candidate.first += h.first->getTotalFrequency(h.second);
+
+        if(top.size() < MAX_FREQ)
+            top.push(candidate);
+        else if(moreFrequent(candidate, top.top()))
+        {
+            top.pop();
+            top.push(candidate);
+        }
+    });
+
+    frequentWords.clear();
+    frequentSummary.clear();
+    for(; !top.empty(); top.pop())
+    {
+        if(top.top().first > 0)
+        {
+            frequentSummary.push_back(Word(top.top().second, PostingList(), top.top().first));
+            frequentWords.update(frequentSummary.back());
+        }
+    }
+}
+
+/**
+ *
+ * startMerge()
+ *
+ * Sorts the segments into tiers by size, and starts a background merge of
+ * the segments of the smallest tier that holds MERGE_FACTOR of them.
+ */
+void SegmentedIndex::startMerge()
+{
+    if(merger.joinable())
+        return;
+
+    std::map<int, std::vector<std::string>> tiers;
+    for(IndexFile* segment : segments)
+    {
+        int tier{0};
+        for(size_t limit = MIN_TIER_SIZE; segment->getSize() > limit; limit *= MERGE_FACTOR)
+            tier++;
+        tiers[tier].push_back(segment->getPath());
+    }
+
+    for(auto& tier : tiers)
+    {
+        if(tier.second.size() >= (size_t) MERGE_FACTOR)
+        {
+            runMerge(tier.second, Parser::documents.getTombstones(), false);
+            return;
+        }
+    }
+}
+
+/**
+ *
+ * runMerge(vector<string>, const PostingList&, bool)
+ *
+ * Starts merging segments on the merge thread. The thread takes a copy of
+ * the tombstones, reads the segments through its own mappings, and swaps
+ * the merged segment into the index file itself, so the index can keep
+ * being searched and written to. A merge of every listed segment compacts
+ * the index, so the index file no longer marks the tombstones it dropped.
+ *
+ * @param inputs        - the paths of the segments to merge
+ * @param tombstones    - the documents whose postings are dropped
+ * @param compacting    - whether the inputs are every segment listed by the
+ *                        index file
+ */
+void SegmentedIndex::runMerge(const std::vector<std::string>& inputs,
+                              const PostingList& tombstones, bool compacting)
+{
+    mergeInputs = inputs;
+    mergeOutput = newSegmentFile();
+    mergeTombstones = tombstones;
+    mergeCompacts = compacting;
+    mergeDone = false;
+
+    std::string indexFile = getIndexFile();
+    merger = std::thread([this, indexFile]
+    {
+        bool merged = mergeSegments(mergeInputs, mergeOutput, mergeTombstones);
+
+        std::lock_guard<std::mutex> lock(mergeLock);
+        merged = merged && IndexFile::replaceSegments(indexFile, mergeInputs, mergeOutput,
+                                                      mergeCompacts ? mergeTombstones : PostingList{});
+        if(!merged)
+            std::remove(mergeOutput.c_str());
+
+        mergeSucceeded = merged;
+        mergeDone = true;
+    });
+}
+
+/**
+ * waitForMerge()
+ *
+ * Waits for a running merge to finish, and swaps in the merged segment.
+ */
+void SegmentedIndex::waitForMerge()
+{
+    if(!merger.joinable())
+        return;
+
+    merger.join();
+    installMerge();
+}
+
+/**
+ *
+ * installMerge()
+ *
+ * Replaces the merged segments with the segment they were merged into. The
+ * words decoded from them stay the same, apart from postings of tombstones
+ * that search results already leave out. Once every segment has been
+ * compacted, the tombstones it dropped are forgotten, and their postings
+ * are removed from the decoded words in place, so those words still match
+ * the index; documents removed since it started stay tombstones.
+ */
+void SegmentedIndex::installMerge()
+{
+    mergeDone = false;
+    if(!mergeSucceeded)
+        return;
+
+    for(auto it = segments.begin(); it != segments.end();)
+    {
+        if(std::find(mergeInputs.begin(), mergeInputs.end(), (*it)->getPath()) != mergeInputs.end())
+        {
+            delete *it;
+            it = segments.erase(it);
+        }
+        else
+            it++;
+    }
+
+    IndexFile* segment = new IndexFile();
+    if(segment->open(mergeOutput))
+        segments.push_back(segment);
+    else
+        delete segment;
+
+    if(!mergeCompacts)
+        return;
+
+    frequentWords.clear();
+    words.removeDocs(mergeTombstones);
+    Parser::documents.setTombstones(PostingList::subtract(Parser::documents.getTombstones(),
+                                                          mergeTombstones));
+    markAllChanged();
+}
+
+/**
+ *
+ * mergeSegments(vector<string>, const std::string&, const PostingList&)
+ *
+ * Merges segments into a single segment. The parts of each word are merged
+ * and the postings of the tombstones are removed, and words left without
+ * documents are dropped. Each word is written as soon as it is merged, so
+ * only one merged word is held at a time, even when every segment is
+ * compacted. The segments are mapped separately from the index, so this
+ * can run on any thread.
+ *
+ * @param inputs        - the paths of the segments to merge
+ * @param output        - the path of the merged segment
+ * @param tombstones    - the documents whose postings are removed
+ * @return              - true if the merged segment was written, false if not
+ */
+bool SegmentedIndex::mergeSegments(const std::vector<std::string>& inputs,
+                                   const std::string& output, const PostingList& tombstones)
+{
+    std::deque<IndexFile> opened(inputs.size());
+    std::vector<IndexFile*> files;
+    uint32_t idLimit{0};
+    for(size_t i{}; i < inputs.size(); i++)
+    {
+        if(!opened[i].open(inputs[i]))
+            return false;
+
+        files.push_back(&opened[i]);
+        idLimit = std::max(idLimit, opened[i].getIdLimit());
+    }
+
+    IndexFile::SegmentWriter writer{output};
+    mergeTerms(files, [&writer, &tombstones](const std::string&,
+                                             std::vector<std::pair<IndexFile*, int>>& holders)
+    {
+        Word word{holders[0].first->getWord(holders[0].second)};
+        for(size_t i{1}; i < holders.size(); i++)
+            word.merge(holders[i].first->getWord(holders[i].second));
+
+        if(!tombstones.empty())
+            word.removeDocs(tombstones);
+        writer.add(word);
+    });
+
+    return writer.finish(idLimit);
+}
+
+/**
+ *
+ * mergeTerms(vector<IndexFile*>, function)
+ *
+ * Walks the sorted term dictionaries of a group of files at the same time,
+ * keeping the next term of each file in a min-heap, so every term is
+ * visited once, in sorted order, with the number of its entry within each
+ * file that holds it.
+ *
+ * @param files - the files whose terms are visited
+ * @param visit - called with each term, and the files and entries holding it
+ */
+void SegmentedIndex::mergeTerms(const std::vector<IndexFile*>& files,
+                                const std::function<void(const std::string&,
+                                                         std::vector<std::pair<IndexFile*, int>>&)>& visit)
+{
+    typedef std::pair<std::string, size_t> Head;
+    std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+    std::vector<int> next(files.size(), 0);
+
+    for(size_t i{}; i < files.size(); i++)
+    {
+        if(files[i]->getNumTerms() > 0)
+            heads.push(Head{files[i]->getTerm(0), i});
+    }
+
+    std::vector<std::pair<IndexFile*, int>> holders;
+    while(!heads.empty())
+    {
+        std::string term = heads.top().first;
+        holders.clear();
+
+        while(!heads.empty() && heads.top().first == term)
+        {
+            size_t i = heads.top().second;
+            heads.pop();
+
+            holders.push_back({files[i], next[i]});
+            if(++next[i] < files[i]->getNumTerms())
+                heads.push(Head{files[i]->getTerm(next[i]), i});
+        }
+        visit(term, holders);
+    }
+}
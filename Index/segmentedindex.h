@@ -0,0 +1,140 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <functional>
+
+#include <Index/mappedindex.h>
+#include <HashTable/hashtable.h>
+
+/**
+ *
+ * SegmentedIndex is a subclass of MappedIndex that can be written to
+ * without loading or rewriting the whole index. The index file becomes a
+ * small manifest holding the document table, the corpus counts, the most
+ * frequent words, and a list of immutable segment files, each of which
+ * holds the terms and postings of the words inserted between two saves.
+ *
+ * New words are inserted into an in-memory hash table, which is written as
+ * a new segment once BUFFER_WORDS words have been inserted, and whenever the
+ * index is saved. Words are searched for in the buffer and in every
+ * segment, and the parts of a word are merged, so a new document can be
+ * searched as soon as it has been parsed.
+ *
+ * Segments are sorted into tiers by size, each tier MERGE_FACTOR times
+ * larger than the one before. Once a tier holds MERGE_FACTOR segments, a
+ * background thread merges them into a single segment of the next tier,
+ * dropping the postings of tombstones, and swaps it into the index file.
+ * The index keeps searching the old segments until its next save, so a
+ * merge never blocks insertion or searching. Compacting the index merges
+ * every segment the index file lists on the same thread, and the
+ * tombstones are forgotten once the merged segment is swapped in.
+ *
+ * By: Oisin Coveney
+ *
+ */
+class SegmentedIndex : public MappedIndex
+{
+    public:
+
+        //Number of words inserted into the buffer before it is written as a segment
+        static const int BUFFER_WORDS = 1 << 22;
+
+        //Number of segments of a tier that are merged into one
+        static const int MERGE_FACTOR = 4;
+
+        //Size in bytes of the segments of the smallest tier
+        static const size_t MIN_TIER_SIZE = 1 << 20;
+
+    private:
+
+        //Words inserted since the last segment was written
+        HashTable buffer;
+        int bufferedWords;
+        bool isEmpty;
+
+        //Number used to name the next segment file
+        int nextSegment;
+
+        //Background merge, and the segments it merges into its output
+        std::thread merger;
+        std::mutex mergeLock;
+        bool mergeDone;
+        bool mergeSucceeded;
+        std::vector<std::string> mergeInputs;
+        std::string mergeOutput;
+
+        //Tombstones the merge drops, whether it compacts every segment, and
+        // whether a compaction waits for the merge running now
+        PostingList mergeTombstones;
+        bool mergeCompacts;
+        bool compactPending;
+
+        //Write the buffer as a new segment
+        bool flush();
+        std::string newSegmentFile();
+
+        //Move the words held by the index file itself into a segment
+        void adoptIndexFile();
+
+        //Find the most frequent words by merging the term dictionaries
+        void findFrequentWords();
+
+        //Background merging of segments
+        void startMerge();
+        void runMerge(const std::vector<std::string>& inputs,
+                      const PostingList& tombstones, bool compacting);
+        void waitForMerge();
+        void installMerge();
+        static bool mergeSegments(const std::vector<std::string>& inputs,
+                                  const std::string& output, const PostingList& tombstones);
+
+        //Visit each term of a group of files in sorted order, with the files that hold it
+        static void mergeTerms(const std::vector<IndexFile*>& files,
+                               const std::function<void(const std::string&,
+                                                        std::vector<std::pair<IndexFile*, int>>&)>& visit);
+
+    public:
+
+        //Constructor
+        SegmentedIndex() : buffer{}, bufferedWords{0}, isEmpty{true}, nextSegment{0},
+                           merger{}, mergeLock{}, mergeDone{false}, mergeSucceeded{false},
+                           mergeInputs{}, mergeOutput{}, mergeTombstones{},
+                           mergeCompacts{false}, compactPending{false} {}
+
+        //Insertion functions
+        Word& insert(std::string& word) override;
+        void insert(std::string& word, uint32_t document) override;
+        void insert(Word word) override;
+        void merge(std::vector<LocalIndex*>& locals, const std::vector<uint32_t>& documents) override;
+        void addToFrequencyList(Word& word) override;
+
+        //Check if empty
+        bool empty() override;
+
+        //Return element, from the buffer and every segment
+        Word& get(const std::string& word) override;
+
+        //Collect every word in the index
+        void getWords(std::vector<Word*>& all) override;
+
+        //Snapshots copy the words of the buffer, and read the rest in place
+        void getUnsavedWords(std::vector<Word*>& all) override;
+        const Word* findUnsaved(const std::string& word) override;
+
+        //Load and print to file
+        bool load() override;
+        void clear() override;
+        void printToFile() override;
+
+        //Merge every segment in the background, dropping the postings of tombstones
+        void compact() override;
+
+        //Destructor
+        ~SegmentedIndex();
+
+        //Returns "segments"
+        std::string getDataType() override;
+};
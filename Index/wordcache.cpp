@@ -0,0 +1,197 @@
+#include <Index/wordcache.h>
+
+const size_t WordCache::DEFAULT_CAPACITY;
+
+/**
+ *
+ * find(const std::string&)
+ *
+ * Finds a word within the cache. A word that isn't pinned is moved to the
+ * front of the list, as the most recently used.
+ *
+ * @param word  - the word to search for
+ * @return      - a pointer to the cached Word, or nullptr if it isn't cached
+ *                or is stale
+ */
+Word* WordCache::find(const std::string& word)
+{
+    auto it = entries.find(word);
+    if(it == entries.end() || it->second.isStale)
+        return nullptr;
+
+    Entry& entry = it->second;
+    if(!entry.isPinned)
+        recent.splice(recent.begin(), recent, entry.position);
+    return &*entry.position;
+}
+
+/**
+ *
+ * insert(const Word&)
+ *
+ * Adds a word to the front of the cache, as the most recently used, and
+ * evicts the least recently used words if the cache has grown past its
+ * capacity. The word must not be cached already, unless it is a stale
+ * pinned word, which is replaced in place.
+ *
+ * @param word  - the word to add
+ * @return      - a reference to the cached Word
+ */
+Word& WordCache::insert(const Word& word)
+{
+    auto it = entries.find(word.getWord());
+    if(it != entries.end())
+    {
+        it->second.isStale = false;
+        *it->second.position = word;
+        return *it->second.position;
+    }
+
+    recent.push_front(word);
+    entries[word.getWord()] = Entry{recent.begin(), false, false};
+    numPostings += word.getNumDocs();
+
+    evict();
+    return recent.front();
+}
+
+/**
+ *
+ * pin(const std::string&)
+ *
+ * Moves a cached word out of the list of recently used words, so it is
+ * never evicted and doesn't count towards the capacity. The word stays at
+ * the same address.
+ *
+ * @param word  - the word to pin, which must be cached
+ * @exception   - out_of_range if the word isn't cached
+ * @return      - a reference to the pinned Word
+ */
+Word& WordCache::pin(const std::string& word)
+{
+    Entry& entry = entries.at(word);
+    if(!entry.isPinned)
+    {
+        numPostings -= entry.position->getNumDocs();
+        pinned.splice(pinned.end(), recent, entry.position);
+        entry.isPinned = true;
+    }
+    return *entry.position;
+}
+
+/**
+ *
+ * invalidate(const std::string&)
+ *
+ * Forgets a word that no longer matches the index. A word that isn't
+ * pinned is removed, and a pinned word is marked as stale, so it isn't
+ * found again until it is inserted anew.
+ *
+ * @param word  - the word to forget
+ */
+void WordCache::invalidate(const std::string& word)
+{
+    auto it = entries.find(word);
+    if(it == entries.end())
+        return;
+
+    Entry& entry = it->second;
+    if(entry.isPinned)
+    {
+        entry.isStale = true;
+        return;
+    }
+
+    numPostings -= entry.position->getNumDocs();
+    recent.erase(entry.position);
+    entries.erase(it);
+}
+
+/**
+ *
+ * removeDocs(const PostingList&)
+ *
+ * Removes documents from every cached word, as compacting the index does
+ * to the words it holds. Words that are left without documents are
+ * forgotten, unless they are pinned.
+ *
+ * @param documents - the documents to remove
+ */
+void WordCache::removeDocs(const PostingList& documents)
+{
+    for(Word& word : pinned)
+        word.removeDocs(documents);
+
+    numPostings = 0;
+    for(auto it = recent.begin(); it != recent.end();)
+    {
+        it->removeDocs(documents);
+        if(it->getNumDocs() == 0)
+        {
+            entries.erase(it->getWord());
+            it = recent.erase(it);
+        }
+        else
+        {
+            numPostings += it->getNumDocs();
+            it++;
+        }
+    }
+}
+
+/**
+ *
+ * evict()
+ *
+ * Removes the least recently used words until the words that aren't pinned
+ * hold no more than the capacity, always keeping the most recent word.
+ */
+void WordCache::evict()
+{
+    while(numPostings > capacity && recent.size() > 1)
+    {
+        numPostings -= recent.back().getNumDocs();
+        entries.erase(recent.back().getWord());
+        recent.pop_back();
+    }
+}
+
+/**
+ * clear()
+ *
+ * Removes every word, pinned or not
+ */
+void WordCache::clear()
+{
+    entries.clear();
+    recent.clear();
+    pinned.clear();
+    numPostings = 0;
+}
+
+/**
+ * empty()
+ * @return  - true if no words are cached, false if not
+ */
+bool WordCache::empty() const
+{
+    return entries.empty();
+}
+
+/**
+ * size()
+ * @return  - the number of cached words, pinned or not
+ */
+int WordCache::size() const
+{
+    return entries.size();
+}
+
+/**
+ * getNumPostings()
+ * @return  - the number of postings held by the words that aren't pinned
+ */
+size_t WordCache::getNumPostings() const
+{
+    return numPostings;
+}
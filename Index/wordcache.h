@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <list>
+#include <unordered_map>
+#include <cstddef>
+
+#include <Word/word.h>
+
+/**
+ * The WordCache class holds the words a MappedIndex has decoded from the
+ * index file, so a word is only decoded again once it has gone unused for
+ * a while. The cache is bounded by the total number of postings of its
+ * words, and when it grows past its capacity the least recently used words
+ * are evicted. The most recently inserted word is never evicted, so a
+ * reference returned by insert() stays valid until the next insertion.
+ *
+ * Words can be pinned, which keeps them out of the capacity and away from
+ * eviction, for words whose address is kept, such as the most frequent
+ * words. A pinned word that no longer matches the index is only marked as
+ * stale, and is replaced in place the next time the word is inserted, so
+ * its address stays valid until the cache is cleared.
+ *
+ * By: Oisin Coveney
+ */
+class WordCache
+{
+    public:
+
+        //Default number of postings held by words that aren't pinned
+        static const size_t DEFAULT_CAPACITY = 1 << 22;
+
+    private:
+
+        //Words in order of use, most recent first, and pinned words
+        std::list<Word> recent;
+        std::list<Word> pinned;
+
+        //Position of every word, whether it is pinned, and whether it is stale
+        struct Entry
+        {
+            std::list<Word>::iterator position;
+            bool isPinned;
+            bool isStale;
+        };
+        std::unordered_map<std::string, Entry> entries;
+
+        //Maximum and current number of postings in the words that aren't pinned
+        size_t capacity;
+        size_t numPostings;
+
+        //Evict the least recently used words until the cache fits its capacity
+        void evict();
+
+    public:
+
+        //Constructor
+        WordCache(size_t capacity = DEFAULT_CAPACITY)
+            : recent{}, pinned{}, entries{}, capacity{capacity}, numPostings{0} {}
+
+        //Find a word, marking it as used, or nullptr if it isn't cached
+        Word* find(const std::string& word);
+
+        //Insert a word that isn't cached, evicting others if needed
+        Word& insert(const Word& word);
+
+        //Keep a cached word until the cache is cleared
+        Word& pin(const std::string& word);
+
+        //Forget a word that no longer matches the index
+        void invalidate(const std::string& word);
+
+        //Remove documents from every cached word, keeping pinned words in place
+        void removeDocs(const PostingList& documents);
+
+        //Remove every word
+        void clear();
+
+        //General functions
+        bool empty() const;
+        int size() const;
+        size_t getNumPostings() const;
+};
@@ -0,0 +1,19 @@
+CONFIG += c++11
+
+TARGET = IndexBench
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TEMPLATE = app
+
+include(IndexEngine.pri)
+
+SOURCES += Benchmark/main.cpp \
+    Benchmark/benchmark.cpp \
+    Server/searchserver.cpp
+
+HEADERS += \
+    Benchmark/benchmark.h \
+    Server/searchserver.h \
+    Server/requestqueue.h
@@ -0,0 +1,19 @@
+CONFIG += c++11
+
+TARGET = IndexCLI
+CONFIG += console c++11
+CONFIG -= app_bundle
+CONFIG -= qt
+
+TEMPLATE = app
+
+include(IndexEngine.pri)
+
+SOURCES += CommandLine/main.cpp \
+    CommandLine/commandline.cpp \
+    Server/searchserver.cpp
+
+HEADERS += \
+    CommandLine/commandline.h \
+    Server/searchserver.h \
+    Server/requestqueue.h
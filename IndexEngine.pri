@@ -0,0 +1,65 @@
+# Sources shared by every target that builds the PDF index:
+# parsing, the index data structures, and query processing.
+
+SOURCES += \
+    HashTable/hashtable.cpp \
+    Index/avlindex.cpp \
+    Index/hashindex.cpp \
+    Index/indexfile.cpp \
+    Index/mappedindex.cpp \
+    Index/wordcache.cpp \
+    Index/segmentedindex.cpp \
+    Index/frequencylist.cpp \
+    Index/indexinterface.cpp \
+    Index/localindex.cpp \
+    Index/indexsnapshot.cpp \
+    Parser/parser.cpp \
+    Parser/ingestpool.cpp \
+    Parser/documentreader.cpp \
+    Parser/unicode.cpp \
+    Parser/fileinfo.cpp \
+    Parser/parseprogress.cpp \
+    Parser/documenttable.cpp \
+    Word/word.cpp \
+    Word/postinglist.cpp \
+    stemmer.cpp \
+    QueryProcessor/queryprocessor.cpp \
+    QueryProcessor/queryparser.cpp \
+    QueryProcessor/resultcache.cpp \
+    Word/docdetails.cpp
+
+HEADERS += \
+    AVLTree/avltree.h \
+    AVLTree/node.h \
+    HashTable/hashtable.h \
+    Index/avlindex.h \
+    Index/hashindex.h \
+    Index/indexinterface.h \
+    Index/localindex.h \
+    Index/indexsnapshot.h \
+    Index/indexfile.h \
+    Index/mappedindex.h \
+    Index/wordcache.h \
+    Index/segmentedindex.h \
+    Index/frequencylist.h \
+    Parser/parser.h \
+    Parser/parseddocument.h \
+    Parser/ingestpool.h \
+    Parser/documentreader.h \
+    Parser/unicode.h \
+    Parser/fileinfo.h \
+    Parser/parseprogress.h \
+    Parser/documenttable.h \
+    Word/word.h \
+    Word/postinglist.h \
+    stemmer.h \
+    QueryProcessor/queryprocessor.h \
+    QueryProcessor/queryparser.h \
+    QueryProcessor/resultcache.h \
+    Word/docdetails.h
+
+LIBS += -lpoppler-cpp \
+        -lstdc++fs
+
+# The posting list decoder uses SSSE3 shuffles on x86
+contains(QT_ARCH, x86_64)|contains(QT_ARCH, i386): QMAKE_CXXFLAGS += -mssse3
@@ -9,34 +9,15 @@ CONFIG -= app_bundle
 
 TEMPLATE = app
 
+include(IndexEngine.pri)
 
 SOURCES += main.cpp \
-    HashTable/hashtable.cpp \
-    Index/avlindex.cpp \
-    Index/hashindex.cpp \
-    Parser/parser.cpp \
-    Word/word.cpp \
-    stemmer.cpp \
-    QueryProcessor/queryprocessor.cpp \
-    Word/docdetails.cpp \
-    gui.cpp
+    gui.cpp \
+    progressrenderer.cpp
 
 HEADERS += \
-    AVLTree/avltree.h \
-    AVLTree/node.h \
-    HashTable/hashtable.h \
-    Index/avlindex.h \
-    Index/hashindex.h \
-    Index/indexinterface.h \
-    Parser/parser.h \
-    Word/word.h \
-    stemmer.h \
-    QueryProcessor/queryprocessor.h \
-    Word/docdetails.h \
-    gui.h
+    gui.h \
+    progressrenderer.h
 
 
-LIBS += -lpoppler-cpp \
-        -lstdc++fs \
-        -lncurses
-
+LIBS += -lncurses
@@ -0,0 +1,127 @@
+#include <Parser/documentreader.h>
+#include <Parser/parser.h>
+
+#include <algorithm>
+
+const int DocumentReader::PAGES_PER_PART;
+poppler::rectf DocumentReader::rectangle{poppler::rectf(0, 0, 500, 500)};
+
+/**
+ * Constructor
+ *
+ * Opens the PDF. If it cannot be opened, the reader has no pages.
+ *
+ * @param file  - the full path of the PDF
+ */
+DocumentReader::DocumentReader(const std::string& file)
+    : file{file}, doc{nullptr}, nextPage{0}, endPage{0}, numPages{0}, parseTime{0.0},
+      started{false}, words{}
+{
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    doc = poppler::document::load_from_file(file);
+    if(doc != nullptr)
+        numPages = doc->pages();
+    endPage = numPages;
+
+    std::chrono::duration<double, std::milli> milliseconds
+            = std::chrono::high_resolution_clock::now() - t1;
+    parseTime += milliseconds.count();
+}
+
+/**
+ * Destructor
+ */
+DocumentReader::~DocumentReader()
+{
+    delete doc;
+}
+
+/**
+ *
+ * setPages(int, int)
+ *
+ * Limits the reader to a range of pages, which are clamped to the pages
+ * of the PDF.
+ *
+ * @param first - the first page to read
+ * @param last  - the page after the last page to read
+ */
+void DocumentReader::setPages(int first, int last)
+{
+    nextPage = std::min(std::max(first, 0), numPages);
+    endPage = std::min(std::max(last, nextPage), numPages);
+}
+
+/**
+ *
+ * next(ParsedDocument&)
+ *
+ * Reads the next PAGES_PER_PART pages of the PDF, or of its range of pages,
+ * into the part, splitting the text of each page into stemmed words and
+ * counting them into the part's term map, which is split into partitions
+ * once the part has been read. The part is complete once the last page has
+ * been read. The part's parse time is the time taken by this reader up to
+ * the end of the part.
+ *
+ * The first part of the PDF is marked as the first, and carries the size,
+ * modification time, and hash of the file. Only the reader of the first
+ * range of a PDF reads its first part, so each file is hashed once.
+ *
+ * @param part  - the ParsedDocument to place the words of the pages into
+ */
+void DocumentReader::next(ParsedDocument& part)
+{
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+
+    part.file = file;
+    part.terms.clear();
+    part.pages = 0;
+
+    //The first part of the PDF carries the details of the file
+    part.first = !started && nextPage == 0;
+    part.info = FileInfo{};
+    if(part.first)
+        FileInfo::read(file, part.info);
+    started = true;
+
+    for(; nextPage < endPage && part.pages < PAGES_PER_PART; nextPage++)
+    {
+        poppler::page* page{doc->create_page(nextPage)};
+        if(page != nullptr)
+        {
+            poppler::byte_array text{page->text(rectangle).to_utf8()};
+            Parser::tokenize(text.data(), text.size(), words);
+            part.terms.add(words);
+            words.clear();
+        }
+        delete page;
+        part.pages++;
+    }
+    part.terms.partition();
+
+    std::chrono::duration<double, std::milli> milliseconds
+            = std::chrono::high_resolution_clock::now() - t1;
+    parseTime += milliseconds.count();
+
+    part.parseTime = parseTime;
+    part.complete = done();
+}
+
+/**
+ * done()
+ * @return  - true if every page of the range has been read, false if not
+ */
+bool DocumentReader::done() const
+{
+    return nextPage >= endPage;
+}
+
+/**
+ * getNumPages()
+ * @return  - the number of pages in the whole PDF, 0 if it couldn't be opened
+ */
+int DocumentReader::getNumPages() const
+{
+    return numPages;
+}
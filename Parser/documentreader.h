@@ -0,0 +1,72 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <poppler/cpp/poppler-document.h>
+#include <poppler/cpp/poppler-page.h>
+#include <poppler/cpp/poppler-rectangle.h>
+
+#include <Parser/parseddocument.h>
+
+/**
+ * The DocumentReader class extracts the text of a PDF a few pages at a
+ * time. Each page is tokenized as soon as its text is extracted, and the
+ * words are handed back in parts of at most PAGES_PER_PART pages, so the
+ * words of a part can be added to an index while the next part is being
+ * read. Only one page of text and one part of words are held at once, no
+ * matter how large the PDF is.
+ *
+ * A reader may be limited to a range of pages, so the ranges of a large
+ * PDF can be read by separate readers, each with its own handle to the PDF.
+ * The reader does not modify any shared state, so a PDF can be read on a
+ * worker thread.
+ *
+ * By: Oisin Coveney
+ */
+class DocumentReader
+{
+    private:
+
+        //Gets maximum possible size for PDF to capture all data
+        static poppler::rectf rectangle;
+
+        //Full path of the PDF, and the PDF itself
+        std::string file;
+        poppler::document* doc;
+
+        //Next page to read, the page to stop before, and the number of pages
+        int nextPage;
+        int endPage;
+        int numPages;
+
+        //Time taken to read the parts so far, in milliseconds
+        double parseTime;
+
+        //Whether a part has been read yet
+        bool started;
+
+        //Words of the page being read
+        std::vector<std::string> words;
+
+    public:
+
+        //Maximum number of pages in a part
+        static const int PAGES_PER_PART = 16;
+
+        //Constructor and destructor
+        DocumentReader(const std::string& file);
+        ~DocumentReader();
+
+        //Only read the pages from first up to, but not including, last
+        void setPages(int first, int last);
+
+        //Read the next part of the PDF
+        void next(ParsedDocument& part);
+
+        //Check if every page has been read
+        bool done() const;
+
+        //Number of pages in the whole PDF
+        int getNumPages() const;
+};
@@ -0,0 +1,297 @@
+#include <Parser/documenttable.h>
+
+const int DocumentTable::CHUNK_SIZE;
+
+/**
+ *
+ * add(const std::string&)
+ *
+ * Adds a document to the table if it is not already in it. New documents
+ * are given the next ID, starting at 0.
+ *
+ * @param path  - the full path of the document
+ * @return      - the ID of the document
+ */
+uint32_t DocumentTable::add(const std::string& path)
+{
+    auto it = ids.find(path);
+    if(it != ids.end())
+        return it->second;
+
+    uint32_t id = numDocuments++;
+    if(id % CHUNK_SIZE == 0)
+    {
+        chunks.push_back(std::make_shared<Chunk>());
+        shared.push_back(false);
+    }
+
+    Chunk& chunk = modify(id);
+    chunk.paths.push_back(path);
+    chunk.wordCounts.push_back(0);
+    chunk.pageCounts.push_back(0);
+    chunk.files.push_back(FileInfo{});
+    chunk.removed.push_back(false);
+    ids[path] = id;
+    return id;
+}
+
+/**
+ *
+ * modify(uint32_t)
+ *
+ * Finds the chunk of a document so it can be changed. A chunk that is
+ * shared with a copy of the table is copied first, so the copy never sees
+ * the change.
+ *
+ * @param id    - the ID of the document
+ * @return      - the chunk of the document, which only this table holds
+ */
+DocumentTable::Chunk& DocumentTable::modify(uint32_t id)
+{
+    size_t c = id / CHUNK_SIZE;
+    if(shared[c])
+    {
+        chunks[c] = std::make_shared<Chunk>(*chunks[c]);
+        shared[c] = false;
+    }
+    return *chunks[c];
+}
+
+/**
+ *
+ * share()
+ *
+ * Makes a read-only copy of the table, such as for a snapshot of the
+ * index, which shares every chunk with this table, so only the list of
+ * chunks and the tombstones are copied. Chunks are marked as shared, and
+ * this table copies each one before it next changes it. The copy has no
+ * index of the paths, so find() doesn't find its documents.
+ *
+ * @return  - the copy of the table
+ */
+std::shared_ptr<const DocumentTable> DocumentTable::share()
+{
+    std::shared_ptr<DocumentTable> copy{new DocumentTable};
+    copy->chunks = chunks;
+    copy->shared.assign(chunks.size(), true);
+    copy->numDocuments = numDocuments;
+    copy->numRemoved = numRemoved;
+    copy->tombstones = tombstones;
+
+    shared.assign(chunks.size(), true);
+    return copy;
+}
+
+/**
+ *
+ * find(const std::string&)
+ *
+ * @param path  - the full path of the document
+ * @return      - the ID of the document, -1 if it isn't in the table
+ */
+int64_t DocumentTable::find(const std::string& path) const
+{
+    auto it = ids.find(path);
+    return (it == ids.end()) ? -1 : (int64_t) it->second;
+}
+
+/**
+ *
+ * remove(uint32_t)
+ *
+ * Marks a document as removed and adds it to the tombstones. The document
+ * keeps its ID and path, but its counts are cleared, and its path can be
+ * added again with a new ID.
+ *
+ * @param id    - the ID of the document to remove
+ */
+void DocumentTable::remove(uint32_t id)
+{
+    if(id >= (uint32_t) numDocuments || isRemoved(id))
+        return;
+
+    auto it = ids.find(getPath(id));
+    if(it != ids.end() && it->second == id)
+        ids.erase(it);
+
+    Chunk& chunk = modify(id);
+    chunk.wordCounts[id % CHUNK_SIZE] = 0;
+    chunk.pageCounts[id % CHUNK_SIZE] = 0;
+    chunk.removed[id % CHUNK_SIZE] = true;
+    numRemoved++;
+    tombstones.add(id);
+}
+
+/**
+ * isRemoved(uint32_t)
+ *
+ * @param id    - the ID of the document
+ * @return      - true if the document has been removed, false if not
+ */
+bool DocumentTable::isRemoved(uint32_t id) const
+{
+    return id < (uint32_t) numDocuments && chunks[id / CHUNK_SIZE]->removed[id % CHUNK_SIZE];
+}
+
+/**
+ * getPath(uint32_t)
+ *
+ * @param id    - the ID of the document
+ * @return      - the full path of the document
+ */
+const std::string& DocumentTable::getPath(uint32_t id) const
+{
+    return chunks[id / CHUNK_SIZE]->paths[id % CHUNK_SIZE];
+}
+
+/**
+ * getWordCount(uint32_t)
+ *
+ * @param id    - the ID of the document
+ * @return      - the number of words parsed from the document
+ */
+int DocumentTable::getWordCount(uint32_t id) const
+{
+    return (id < (uint32_t) numDocuments) ? chunks[id / CHUNK_SIZE]->wordCounts[id % CHUNK_SIZE] : 0;
+}
+
+/**
+ * setWordCount(uint32_t, int)
+ *
+ * @param id    - the ID of the document
+ * @param count - the number of words parsed from the document
+ */
+void DocumentTable::setWordCount(uint32_t id, int count)
+{
+    modify(id).wordCounts[id % CHUNK_SIZE] = count;
+}
+
+/**
+ * addWords(uint32_t, int)
+ *
+ * @param id    - the ID of the document
+ * @param count - the number of words to add to the document's word count
+ */
+void DocumentTable::addWords(uint32_t id, int count)
+{
+    modify(id).wordCounts[id % CHUNK_SIZE] += count;
+}
+
+/**
+ * getTombstones()
+ * @return  - the removed documents whose postings are still in the index
+ */
+const PostingList& DocumentTable::getTombstones() const
+{
+    return tombstones;
+}
+
+/**
+ * setTombstones(const PostingList&)
+ *
+ * @param value - the removed documents whose postings are still in the index
+ */
+void DocumentTable::setTombstones(const PostingList& value)
+{
+    tombstones = value;
+}
+
+/**
+ * clearTombstones()
+ *
+ * Forgets the tombstones once their postings have been compacted away.
+ * The documents stay removed.
+ */
+void DocumentTable::clearTombstones()
+{
+    tombstones = PostingList{};
+}
+
+/**
+ * getPageCount(uint32_t)
+ *
+ * @param id    - the ID of the document
+ * @return      - the number of pages parsed from the document
+ */
+int DocumentTable::getPageCount(uint32_t id) const
+{
+    return (id < (uint32_t) numDocuments) ? chunks[id / CHUNK_SIZE]->pageCounts[id % CHUNK_SIZE] : 0;
+}
+
+/**
+ * setPageCount(uint32_t, int)
+ *
+ * @param id    - the ID of the document
+ * @param count - the number of pages parsed from the document
+ */
+void DocumentTable::setPageCount(uint32_t id, int count)
+{
+    modify(id).pageCounts[id % CHUNK_SIZE] = count;
+}
+
+/**
+ * addPages(uint32_t, int)
+ *
+ * @param id    - the ID of the document
+ * @param count - the number of pages to add to the document's page count
+ */
+void DocumentTable::addPages(uint32_t id, int count)
+{
+    modify(id).pageCounts[id % CHUNK_SIZE] += count;
+}
+
+/**
+ * getFileInfo(uint32_t)
+ *
+ * @param id    - the ID of the document
+ * @return      - the size, modification time, and hash of the document's file
+ *                when it was parsed
+ */
+const FileInfo& DocumentTable::getFileInfo(uint32_t id) const
+{
+    return chunks[id / CHUNK_SIZE]->files[id % CHUNK_SIZE];
+}
+
+/**
+ * setFileInfo(uint32_t, const FileInfo&)
+ *
+ * @param id    - the ID of the document
+ * @param info  - the size, modification time, and hash of the document's file
+ */
+void DocumentTable::setFileInfo(uint32_t id, const FileInfo& info)
+{
+    modify(id).files[id % CHUNK_SIZE] = info;
+}
+
+/**
+ * size()
+ * @return  - the number of documents in the table, including removed ones
+ */
+int DocumentTable::size() const
+{
+    return numDocuments;
+}
+
+/**
+ * getNumLive()
+ * @return  - the number of documents in the table that haven't been removed
+ */
+int DocumentTable::getNumLive() const
+{
+    return numDocuments - numRemoved;
+}
+
+/**
+ * clear()
+ *
+ * Removes every document from the table
+ */
+void DocumentTable::clear()
+{
+    chunks.clear();
+    shared.clear();
+    numDocuments = 0;
+    numRemoved = 0;
+    tombstones = PostingList{};
+    ids.clear();
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+
+#include <Parser/fileinfo.h>
+#include <Word/postinglist.h>
+
+/**
+ * The DocumentTable class is the registry of every document in the index.
+ * Each document is given a compact integer ID when it is first parsed, and
+ * postings refer to documents by that ID. The table keeps the path, word
+ * count, and page count of each document, so a path is only looked up when
+ * a result is displayed.
+ *
+ * The table is also the manifest of the index: it keeps the FileInfo of
+ * every document as it was when the document was parsed. A document that
+ * is removed keeps its ID, so the IDs of later documents don't change, but
+ * its path is freed to be added again with a new ID.
+ *
+ * Removing a document only sets its bit in the bitmap of removed documents
+ * and adds it to the tombstones, which takes constant time. Its postings
+ * stay in the index, and are filtered out of search results by the
+ * tombstones until they are compacted away.
+ *
+ * The documents are kept in chunks of CHUNK_SIZE. share() makes a read-only
+ * copy of the table for a snapshot of the index, which shares every chunk
+ * with the table, and the table copies a chunk only when it next changes
+ * one that is shared. Publishing a snapshot after a batch of documents
+ * therefore only copies the chunks the batch touched, however many
+ * documents there are.
+ *
+ * NOTE: The word counts are the counts of words that have been parsed,
+ *       which does not include words shorter than 3, or stop words.
+ *
+ * By: Oisin Coveney
+ */
+class DocumentTable
+{
+    public:
+
+        //Number of documents in each chunk of the table
+        static const int CHUNK_SIZE = 1024;
+
+    private:
+
+        //Path, word count, page count, file details, and whether it was removed, of each document of a chunk
+        struct Chunk
+        {
+            std::vector<std::string> paths;
+            std::vector<int> wordCounts;
+            std::vector<int> pageCounts;
+            std::vector<FileInfo> files;
+            std::vector<bool> removed;
+        };
+
+        //Chunks of the documents, indexed by ID / CHUNK_SIZE, and whether
+        // each is shared with a copy and must be copied before it changes
+        std::vector<std::shared_ptr<Chunk>> chunks;
+        std::vector<bool> shared;
+
+        //Number of documents, and the number that have been removed
+        int numDocuments;
+        int numRemoved;
+
+        //Removed documents whose postings are still in the index
+        PostingList tombstones;
+
+        //ID of each path, which copies made by share() don't have
+        std::unordered_map<std::string, uint32_t> ids;
+
+        //The chunk of a document, copied first if it is shared
+        Chunk& modify(uint32_t id);
+
+    public:
+
+        //Constructor
+        DocumentTable() : chunks{}, shared{}, numDocuments{0}, numRemoved{0},
+            tombstones{}, ids{} {}
+
+        //Tables share their chunks only through share()
+        DocumentTable(const DocumentTable& other) = delete;
+        DocumentTable& operator=(const DocumentTable& other) = delete;
+
+        //Make a read-only copy of the table that shares its chunks
+        std::shared_ptr<const DocumentTable> share();
+
+        //Add a document, returning its ID
+        uint32_t add(const std::string& path);
+
+        //Find the ID of a document, -1 if it doesn't exist or was removed
+        int64_t find(const std::string& path) const;
+
+        //Remove a document, keeping its ID
+        void remove(uint32_t id);
+        bool isRemoved(uint32_t id) const;
+
+        //Removed documents whose postings haven't been compacted
+        const PostingList& getTombstones() const;
+        void setTombstones(const PostingList& value);
+        void clearTombstones();
+
+        //Getters and setters
+        const std::string& getPath(uint32_t id) const;
+        int getWordCount(uint32_t id) const;
+        void setWordCount(uint32_t id, int count);
+        void addWords(uint32_t id, int count);
+        int getPageCount(uint32_t id) const;
+        void setPageCount(uint32_t id, int count);
+        void addPages(uint32_t id, int count);
+        const FileInfo& getFileInfo(uint32_t id) const;
+        void setFileInfo(uint32_t id, const FileInfo& info);
+
+        //Number of documents, including removed ones, and the number not removed
+        int size() const;
+        int getNumLive() const;
+
+        //Clear the table
+        void clear();
+};
@@ -0,0 +1,109 @@
+#include <Parser/fileinfo.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <sys/stat.h>
+
+/**
+ * mix(uint64_t)
+ *
+ * Spreads every bit of a value over the whole value, so hashes that differ
+ * in a few bits end up far apart.
+ *
+ * @param value - the value to mix
+ * @return      - the mixed value
+ */
+static uint64_t mix(uint64_t value)
+{
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdull;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+/**
+ *
+ * stat(const std::string&, FileInfo&)
+ *
+ * Reads the size and modification time of a file, leaving its hash alone.
+ *
+ * @param file  - the full path of the file
+ * @param info  - the FileInfo to place the size and modification time into
+ * @return      - true if the file exists, false if not
+ */
+bool FileInfo::stat(const std::string& file, FileInfo& info)
+{
+    struct ::stat st;
+    if(::stat(file.c_str(), &st) != 0)
+        return false;
+
+    info.size = st.st_size;
+    info.modifiedTime = (int64_t) st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+    return true;
+}
+
+/**
+ *
+ * read(const std::string&, FileInfo&)
+ *
+ * Reads the size and modification time of a file, and hashes its contents.
+ *
+ * @param file  - the full path of the file
+ * @param info  - the FileInfo to fill in
+ * @return      - true if the file exists, false if not
+ */
+bool FileInfo::read(const std::string& file, FileInfo& info)
+{
+    if(!stat(file, info))
+        return false;
+
+    info.contentHash = hash(file);
+    return true;
+}
+
+/**
+ *
+ * hash(const std::string&)
+ *
+ * Hashes the contents of a file 8 bytes at a time, reading it in blocks
+ * of 64 KB. Each 8 bytes are mixed into the hash with a multiply and a
+ * rotate, and the length of the file is mixed in at the end, which is
+ * enough to tell an edited PDF from the one that was indexed.
+ *
+ * @param file  - the full path of the file
+ * @return      - the hash of the contents, 0 if the file can't be read
+ */
+uint64_t FileInfo::hash(const std::string& file)
+{
+    std::FILE* f = std::fopen(file.c_str(), "rb");
+    if(f == nullptr)
+        return 0;
+
+    std::vector<char> buffer(1 << 16);
+    uint64_t hash = 0x9e3779b97f4a7c15ull;
+    uint64_t length{0};
+
+    size_t n;
+    while((n = std::fread(buffer.data(), 1, buffer.size(), f)) > 0)
+    {
+        length += n;
+
+        //Pad the last few bytes of the file with zeros
+        while(n % 8 != 0)
+            buffer[n++] = 0;
+
+        for(size_t i{}; i < n; i += 8)
+        {
+            uint64_t value;
+            std::memcpy(&value, buffer.data() + i, 8);
+            hash ^= value * 0x87c37b91114253d5ull;
+            hash = ((hash << 27) | (hash >> 37)) * 5 + 0x52dce729;
+        }
+    }
+    std::fclose(f);
+
+    return mix(hash ^ length);
+}
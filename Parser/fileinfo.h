@@ -0,0 +1,41 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/**
+ * The FileInfo struct holds what the index remembers about a PDF on disk:
+ * its size, the time it was last modified, and a hash of its contents.
+ * Together they make up the manifest of the index, which lets the Parser
+ * tell whether a file has changed since it was indexed without parsing it
+ * again.
+ *
+ * The size and modification time are checked first, since they only need
+ * a stat of the file. The file is only hashed when they have changed, so a
+ * file that was copied or touched without being edited is not re-parsed.
+ *
+ * By: Oisin Coveney
+ */
+struct FileInfo
+{
+        //Size of the file in bytes
+        uint64_t size;
+
+        //Time the file was last modified, in nanoseconds since the epoch
+        int64_t modifiedTime;
+
+        //Hash of the contents of the file
+        uint64_t contentHash;
+
+        //Constructor
+        FileInfo() : size{0}, modifiedTime{0}, contentHash{0} {}
+
+        //Read the size and modification time of a file
+        static bool stat(const std::string& file, FileInfo& info);
+
+        //Read the size, modification time, and hash of a file
+        static bool read(const std::string& file, FileInfo& info);
+
+        //Hash the contents of a file
+        static uint64_t hash(const std::string& file);
+};
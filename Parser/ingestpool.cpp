@@ -0,0 +1,191 @@
+#include <Parser/ingestpool.h>
+
+#include <algorithm>
+
+const int IngestPool::RANGE_PAGES;
+
+/**
+ * Constructor
+ *
+ * Starts the worker threads, which immediately begin parsing the files.
+ * The workers may run up to four ranges each ahead of the consumer.
+ *
+ * @param files         - the list of files to parse
+ * @param numThreads    - the number of worker threads to start
+ */
+IngestPool::IngestPool(const std::vector<std::string>& files, int numThreads)
+    : files{files}, results{}, claimFile{0}, claimRange{0}, claimFileRanges{-1},
+      nextToClaim{0}, nextToDeliver{0}, earlierParseTime{0.0}, filesDelivered{0},
+      stopping{false}
+{
+    if(numThreads < 1)
+        numThreads = 1;
+
+    results.resize(4 * numThreads);
+    for(Range& range : results)
+        range.finished = false;
+
+    for(int i{}; i < numThreads; i++)
+        workers.push_back(std::thread(&IngestPool::work, this));
+}
+
+/**
+ * Destructor
+ *
+ * Waits for all workers to finish before the pool is destroyed. If the
+ * consumer stops early, the remaining files and pages are skipped.
+ */
+IngestPool::~IngestPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    slotFree.notify_all();
+
+    for(std::thread& t : workers)
+        t.join();
+}
+
+/**
+ * advanceClaim()
+ *
+ * Moves the next range to claim on to the first range of the next file once
+ * every range of the current file has been claimed. Must be called with the
+ * lock held.
+ */
+void IngestPool::advanceClaim()
+{
+    if(claimFileRanges != -1 && claimRange >= claimFileRanges)
+    {
+        claimFile++;
+        claimRange = 0;
+        claimFileRanges = -1;
+    }
+}
+
+/**
+ *
+ * work()
+ *
+ * Claims the next range in order and reads it one part at a time outside
+ * of the lock, placing each part into the range's slot of the ring buffer.
+ *
+ * The worker that claims the first range of a file opens it and splits it
+ * into ranges, and no later range can be claimed until it has. A worker
+ * waits when its range would overwrite a slot the consumer has not finished
+ * with yet. A range holds at most four parts, so a worker never waits
+ * while reading one.
+ */
+void IngestPool::work()
+{
+    int window = (int) results.size();
+
+    while(true)
+    {
+        int file, range, numRanges, slot;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            slotFree.wait(guard, [this, window]
+            {
+                return stopping || claimFile >= (int) files.size()
+                        || ((claimRange == 0 || claimFileRanges != -1)
+                            && nextToClaim < nextToDeliver + window);
+            });
+
+            if(stopping || claimFile >= (int) files.size())
+                return;
+
+            file = claimFile;
+            range = claimRange++;
+            numRanges = claimFileRanges;
+            slot = nextToClaim++ % window;
+            advanceClaim();
+        }
+
+        DocumentReader reader{files[file]};
+
+        //Split the file into ranges, letting other workers claim the rest
+        if(range == 0)
+        {
+            numRanges = std::max(1, (reader.getNumPages() + RANGE_PAGES - 1) / RANGE_PAGES);
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                claimFileRanges = numRanges;
+                advanceClaim();
+            }
+            slotFree.notify_all();
+        }
+        reader.setPages(range * RANGE_PAGES, (range + 1) * RANGE_PAGES);
+
+        bool finished;
+        do
+        {
+            ParsedDocument part;
+            reader.next(part);
+
+            //Only the last part of the last range completes the document
+            finished = part.complete;
+            part.complete = finished && range == numRanges - 1;
+
+            {
+                std::lock_guard<std::mutex> guard(lock);
+                if(stopping)
+                    return;
+
+                results[slot].parts.push_back(std::move(part));
+                results[slot].finished = finished;
+            }
+            resultReady.notify_all();
+        }
+        while(!finished);
+    }
+}
+
+/**
+ *
+ * next(ParsedDocument&)
+ *
+ * Waits for the next part in file and page order to be parsed and moves it
+ * into the parameter. The parse time of the last part of a document is the
+ * time taken to read every range of the document.
+ *
+ * @param part  - the ParsedDocument to move the part into
+ * @return      - false if every file has been handed back, true if not
+ */
+bool IngestPool::next(ParsedDocument& part)
+{
+    int window = (int) results.size();
+
+    std::unique_lock<std::mutex> guard(lock);
+    if(filesDelivered >= (int) files.size())
+        return false;
+
+    Range& range = results[nextToDeliver % window];
+    resultReady.wait(guard, [&range] { return !range.parts.empty(); });
+
+    part = std::move(range.parts.front());
+    range.parts.pop_front();
+
+    //Move on to the next range once this one is finished
+    if(range.parts.empty() && range.finished)
+    {
+        range.finished = false;
+        nextToDeliver++;
+
+        if(part.complete)
+        {
+            part.parseTime += earlierParseTime;
+            earlierParseTime = 0.0;
+            filesDelivered++;
+        }
+        else
+        {
+            earlierParseTime += part.parseTime;
+        }
+    }
+
+    guard.unlock();
+    slotFree.notify_all();
+    return true;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <Parser/parseddocument.h>
+#include <Parser/documentreader.h>
+
+/**
+ * The IngestPool class is a pool of worker threads that extract and
+ * tokenize a list of PDFs concurrently. Each PDF is split into ranges of
+ * RANGE_PAGES pages, and every range is read by its own worker with its own
+ * DocumentReader, so the pages of a very large PDF are extracted in
+ * parallel instead of on a single thread. The parts of every range are
+ * handed back through next() in the order of the file list and its pages,
+ * so the index built from them is identical to one built by parsing the
+ * files serially.
+ *
+ * Ranges are claimed in that same order, and workers may only run a fixed
+ * window of ranges ahead of the consumer, which bounds the memory held no
+ * matter how large the PDFs are.
+ *
+ * By: Oisin Coveney
+ */
+class IngestPool
+{
+    public:
+
+        //Number of pages in each range read by a worker
+        static const int RANGE_PAGES = 4 * DocumentReader::PAGES_PER_PART;
+
+    private:
+
+        //The parts of a range waiting to be indexed
+        struct Range
+        {
+            std::deque<ParsedDocument> parts;
+            bool finished;
+        };
+
+        //The files to parse
+        const std::vector<std::string>& files;
+
+        //Ring buffer of the ranges claimed by workers
+        std::vector<Range> results;
+
+        //Next range for a worker to claim: its file, its range within the
+        //file, the number of ranges in the file (-1 until the file is
+        //opened), and its number in the order of every range
+        int claimFile;
+        int claimRange;
+        int claimFileRanges;
+        int nextToClaim;
+
+        //Next range to hand back, the parse time of the earlier ranges of
+        //its document, and the number of documents handed back
+        int nextToDeliver;
+        double earlierParseTime;
+        int filesDelivered;
+
+        //Move the next range to claim on to the next file once every range
+        //of the current file has been claimed
+        void advanceClaim();
+
+        //Set when the pool is destroyed before every file is handed back
+        bool stopping;
+
+        //Synchronization between the workers and the consumer
+        std::mutex lock;
+        std::condition_variable resultReady;
+        std::condition_variable slotFree;
+
+        std::vector<std::thread> workers;
+
+        //Loop run by every worker thread
+        void work();
+
+    public:
+
+        //Constructor and destructor
+        IngestPool(const std::vector<std::string>& files, int numThreads);
+        ~IngestPool();
+
+        //Get the next part of a parsed document in file order
+        bool next(ParsedDocument& part);
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Parser/fileinfo.h>
+#include <Index/localindex.h>
+
+/**
+ * The ParsedDocument struct holds the result of extracting and tokenizing
+ * a PDF, or a part of its pages, before it is added to an index. Extraction
+ * does not touch any shared state, so documents can be parsed on worker
+ * threads and then added to the IndexInterface in their original order.
+ * The words are counted into a LocalIndex by the worker, so they are
+ * merged into the index once per document rather than once per occurrence.
+ *
+ * Large PDFs are read by a DocumentReader in parts of a few pages. Every
+ * part names the same file, and only the last part is complete. The first
+ * part carries the FileInfo of the PDF, which is recorded in the manifest.
+ *
+ * By: Oisin Coveney
+ */
+struct ParsedDocument
+{
+        //Full path of the PDF
+        std::string file;
+
+        //Number of pages in the PDF, or in this part of it
+        int pages;
+
+        //Stemmed words of the document, counted into a term map
+        LocalIndex terms;
+
+        //Time taken to extract and tokenize the document, up to the end of this part
+        double parseTime;
+
+        //Whether this is the first or the last part of the document
+        bool first;
+        bool complete;
+
+        //Size, modification time, and hash of the PDF, set in the first part
+        FileInfo info;
+
+        //Constructor
+        ParsedDocument() : file{}, pages{0}, terms{}, parseTime{0.0},
+            first{true}, complete{true}, info{} {}
+};
@@ -0,0 +1,72 @@
+#include <Parser/parseprogress.h>
+
+/**
+ *
+ * reset(int)
+ *
+ * Clears the counters and the list of recent files for a new parse.
+ *
+ * @param files - the number of files that will be parsed
+ */
+void ParseProgress::reset(int files)
+{
+    std::lock_guard<std::mutex> guard(fileLock);
+    recentFiles.clear();
+    totalParseTime = 0;
+    filesParsed = 0;
+    totalFiles = files;
+}
+
+/**
+ *
+ * fileParsed(const std::string&, double, int, int)
+ *
+ * Publishes a file that has been added to the index along with the new
+ * page and word totals.
+ *
+ * @param file          - the full path of the file
+ * @param parseTime     - the time taken to parse the file in milliseconds
+ * @param totalPages    - the total number of pages parsed
+ * @param totalWords    - the total number of words parsed
+ */
+void ParseProgress::fileParsed(const std::string& file, double parseTime,
+                               int totalPages, int totalWords)
+{
+    {
+        std::lock_guard<std::mutex> guard(fileLock);
+        recentFiles.push_front(file);
+        if((int) recentFiles.size() > MAX_RECENT)
+            recentFiles.pop_back();
+    }
+
+    totalParseTime += (long long) (parseTime * 1000);
+    pages = totalPages;
+    words = totalWords;
+    filesParsed++;
+}
+
+/**
+ * getAverageParseTime()
+ *
+ * @return  - the average parse time of a file in milliseconds
+ */
+double ParseProgress::getAverageParseTime() const
+{
+    int files = filesParsed;
+    return (files == 0) ? 0.0 : (totalParseTime / 1000.0) / files;
+}
+
+/**
+ *
+ * getRecentFiles(int)
+ *
+ * @param count - the maximum number of files to return
+ * @return      - the most recently parsed files, newest first
+ */
+std::vector<std::string> ParseProgress::getRecentFiles(int count)
+{
+    std::lock_guard<std::mutex> guard(fileLock);
+    if(count > (int) recentFiles.size())
+        count = (int) recentFiles.size();
+    return std::vector<std::string>(recentFiles.begin(), recentFiles.begin() + count);
+}
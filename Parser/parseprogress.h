@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <deque>
+#include <vector>
+
+/**
+ * The ParseProgress class holds the counters the Parser publishes while it
+ * builds an index. The Parser only stores to the counters once per
+ * document, and anything that wants to display progress (such as the
+ * ProgressRenderer used by the GUI) reads them from its own thread.
+ *
+ * Nothing in this class depends on a user interface, so a headless build
+ * pays only for a few atomic stores per document.
+ *
+ * By: Oisin Coveney
+ */
+class ParseProgress
+{
+    private:
+
+        //Most recently parsed files, newest first
+        std::deque<std::string> recentFiles;
+        std::mutex fileLock;
+
+        //Total parse time of every file, in microseconds
+        std::atomic<long long> totalParseTime;
+
+    public:
+
+        //Maximum number of recent files kept for display
+        static const int MAX_RECENT = 128;
+
+        //Counters for the current parse
+        std::atomic<int> filesParsed;
+        std::atomic<int> totalFiles;
+        std::atomic<int> pages;
+        std::atomic<int> words;
+
+        //Constructor
+        ParseProgress()
+            : recentFiles{}, totalParseTime{0}, filesParsed{0},
+              totalFiles{0}, pages{0}, words{0} {}
+
+        //Start a new parse of the given number of files
+        void reset(int files);
+
+        //Publish a parsed file
+        void fileParsed(const std::string& file, double parseTime,
+                        int totalPages, int totalWords);
+
+        //Readers
+        double getAverageParseTime() const;
+        std::vector<std::string> getRecentFiles(int count);
+};
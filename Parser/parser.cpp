@@ -1,11 +1,20 @@
 #include <Parser/parser.h>
+#include <Parser/ingestpool.h>
+#include <Parser/documentreader.h>
+#include <Parser/unicode.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 /**
  *
  * getFileList(std::string, std::vector<std::string>)
  *
  * Gets the file list using the std::experimental::filesystem library,
- * finding all PDFs in a directory *recursively*.
+ * finding all PDFs in a directory *recursively*. The paths of the PDFs are
+ * absolute, so a file is known by the same path however the directory
+ * was given.
  *
  * With some help from: https://goo.gl/AZV6UJ
  *
@@ -16,7 +25,7 @@
 int Parser::getFileList(std::string directory, std::vector<std::string>& files)
 {
     namespace fs = std::experimental::filesystem;
-    for (fs::recursive_directory_iterator i(directory), end; i != end; ++i)
+    for (fs::recursive_directory_iterator i(fs::absolute(directory)), end; i != end; ++i)
     {
         fs::path p = i->path();
         if (!fs::is_directory(p) && p.extension() == ".pdf"
@@ -34,59 +43,308 @@ int Parser::getFileList(std::string directory, std::vector<std::string>& files)
  * parseFile(std::string&, IndexInterface*&)
  *
  * Parses a single PDF file and inserts the words in the document
- * into the IndexInterface provided through the parameter.
+ * into the IndexInterface provided through the parameter. Each part of
+ * the document is inserted as soon as it has been read.
  *
  * @param file  - the string containing the full path of the file
  * @param index - a pointer reference to the IndexInterface with the PDF index
  */
 void Parser::parseFile(std::string& file, IndexInterface*& index)
 {
-    //Get the document
-    poppler::document* doc{poppler::document::load_from_file(file)};
-
-    std::string text;
-
-    //Places all text in the document into a string
-    for(int i{}; i < doc->pages(); i++)
+    DocumentReader reader{file};
+    ParsedDocument part;
+    do
     {
-        std::string pageStr = ("Pages: " + std::to_string(Parser::numPages));
-        mvprintw(3, 25, pageStr.c_str());
-        refresh();
-        numPages++;
-        poppler::page* page{doc->create_page(i)};
-        text += page->text(rectangle).to_latin1();
-        delete page;
+        reader.next(part);
+        indexDocument(part, index);
     }
+    while(!part.complete);
+}
 
-    //Removes all unwanted characters and makes all letters lowercase
-    for(std::string::iterator it = text.begin(); it != text.end(); ++it)
+/**
+ *
+ * makeLetterTable()
+ *
+ * Builds the table used to classify characters while tokenizing. Letters
+ * map to their lowercase letter, and every other character maps to 0.
+ *
+ * @return  - the table, indexed by unsigned character
+ */
+static std::array<char, 256> makeLetterTable()
+{
+    std::array<char, 256> table{};
+    for(int c{'a'}; c <= 'z'; c++)
     {
-        char& c = *it;
-        isalpha(c) ? c = tolower(c) : c = ' ';
+        table[c] = c;
+        table[c - 'a' + 'A'] = c;
     }
+    return table;
+}
 
-    std::stringstream buffer(text);
+static const std::array<char, 256> letters{makeLetterTable()};
+
+/**
+ *
+ * tokenize(const std::string&, std::vector<std::string>&)
+ *
+ * Splits UTF-8 text into stemmed words, skipping words shorter than 3
+ * letters and stop words.
+ *
+ * @param text  - the text to split into words
+ * @param words - the vector to add the stemmed words to
+ */
+void Parser::tokenize(const std::string& text, std::vector<std::string>& words)
+{
+    tokenize(text.data(), text.size(), words);
+}
+
+/**
+ *
+ * tokenize(const char*, size_t, std::vector<std::string>&)
+ *
+ * Splits UTF-8 text into stemmed words, skipping words shorter than 3
+ * letters and stop words. Words are runs of letters, which are normalized
+ * and made lowercase as they are read. Each word is read into the same
+ * buffer, so only the words that are kept are copied.
+ *
+ * ASCII text is read 16 bytes at a time with SSE2 where available, and a
+ * byte at a time with a table lookup otherwise. Any other character is
+ * decoded and normalized through the Unicode class.
+ *
+ * @param text      - the text to split into words
+ * @param length    - the number of bytes in the text
+ * @param words     - the vector to add the stemmed words to
+ */
+void Parser::tokenize(const char* text, size_t length, std::vector<std::string>& words)
+{
+    const char* it = text;
+    const char* end = text + length;
 
     std::string str;
+    str.reserve(64);
+
+    while(it != end)
+    {
+        unsigned char c = *it;
+        if(c < 0x80)
+        {
+#if defined(__SSE2__)
+            if(end - it >= 16)
+            {
+                //Bytes with 0x20 set are lowercase, and only letters lie between 'a' and 'z'
+                __m128i bytes = _mm_loadu_si128((const __m128i*) it);
+                __m128i lower = _mm_or_si128(bytes, _mm_set1_epi8(0x20));
+                __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                                 _mm_cmplt_epi8(lower, _mm_set1_epi8('z' + 1)));
+                uint32_t letterMask = _mm_movemask_epi8(isLetter);
+
+                if(letterMask & 1)
+                {
+                    //Append the letters up to the first byte that isn't one
+                    char buffer[16];
+                    _mm_storeu_si128((__m128i*) buffer, lower);
+                    int count = __builtin_ctz(~letterMask);
+                    str.append(buffer, count);
+                    it += count;
+                }
+                else
+                {
+                    //Skip to the next letter or non-ASCII byte
+                    uint32_t stops = letterMask | _mm_movemask_epi8(bytes) | 0x10000;
+                    addWord(str, false, words);
+                    it += __builtin_ctz(stops);
+                }
+                continue;
+            }
+#endif
+            if(letters[c] != 0)
+                str.push_back(letters[c]);
+            else
+                addWord(str, false, words);
+            ++it;
+        }
+        else
+        {
+            uint32_t codePoint = Unicode::decode(it, end);
+            switch(Unicode::classify(codePoint))
+            {
+                case Unicode::LETTER:
+                    Unicode::appendFolded(codePoint, str);
+                    break;
+
+                case Unicode::IDEOGRAPH:
+                    addWord(str, false, words);
+                    Unicode::encode(codePoint, str);
+                    addWord(str, true, words);
+                    break;
+
+                default:
+                    addWord(str, false, words);
+            }
+        }
+    }
+    addWord(str, false, words);
+}
+
+/**
+ *
+ * addWord(std::string&, bool, std::vector<std::string>&)
+ *
+ * Stems a word and adds it to the vector, unless it is shorter than 3
+ * letters or is a stop word, and then clears the word. Ideographs are
+ * words on their own, so they are never too short. Only ASCII words are
+ * stemmed, since the stemmer is for English.
+ *
+ * Stemming is most of the cost of tokenizing, and most words of a text are
+ * repeats, so every thread keeps the stems of the words it has seen. Stop
+ * words are kept with an empty stem. The cache is emptied once it holds
+ * STEM_CACHE_SIZE words.
+ *
+ * @param str       - the word to add, which is cleared
+ * @param ideograph - true if the word is a single ideograph
+ * @param words     - the vector to add the stemmed word to
+ */
+void Parser::addWord(std::string& str, bool ideograph, std::vector<std::string>& words)
+{
+    static thread_local std::unordered_map<std::string, std::string> stems;
+
+    if(str.empty())
+        return;
 
-    //Moves through each word in the string and adds to the file if the
-    // word is longer than 3 and is not a stop word.
-    while(buffer >> str)
+    if(ideograph || !invalidLength(str))
     {
-        if(!invalidLength(str) && !isStopWord(str))
+        auto stem = stems.find(str);
+        if(stem == stems.end())
         {
-            std::string wordsStr = ("Words: "
-                                    + std::to_string(Parser::numWords));
-            mvprintw(3, 45, wordsStr.c_str());
-            refresh();
-            numWords++;
-            totalWordsInDoc[file]++;
-            Porter2Stemmer::stem(str);
-            index->insert(str, file);
+            if(stems.size() >= STEM_CACHE_SIZE)
+                stems.clear();
+
+            std::string stemmed;
+            if(!isStopWord(str))
+            {
+                stemmed = str;
+                if(Unicode::isAscii(stemmed))
+                    Porter2Stemmer::stem(stemmed);
+            }
+            stem = stems.emplace(str, stemmed).first;
         }
 
+        //Keep the word if it is not a stop word
+        if(!stem->second.empty())
+            words.push_back(stem->second);
     }
-    delete doc;
+    str.clear();
+}
+
+/**
+ *
+ * indexDocument(ParsedDocument&, IndexInterface*&)
+ *
+ * Inserts the words of a parsed document, or a part of one, into the
+ * IndexInterface, as a batch of a single document.
+ *
+ * @param document  - the ParsedDocument containing the words to add
+ * @param index     - a pointer reference to the IndexInterface with the PDF index
+ */
+void Parser::indexDocument(ParsedDocument& document, IndexInterface*& index)
+{
+    std::vector<ParsedDocument*> batch{&document};
+    indexDocuments(batch, index);
+}
+
+/**
+ *
+ * indexDocuments(std::vector<ParsedDocument*>&, IndexInterface*&)
+ *
+ * Inserts the words of a batch of parsed documents, or parts of them, into
+ * the IndexInterface, and adds them to the page and word counts and the
+ * DocumentTable. The counts and the table are updated on this thread, and
+ * then the term maps of the batch are merged into the index by the
+ * Parser's threads. The first part of a document records its file in the
+ * manifest. Once the last part of a document is inserted, the totals up to
+ * that document are published through the ParseProgress object. If the
+ * index is being searched through snapshots, a new snapshot is published
+ * once PUBLISH_INTERVAL_MS have passed since the last one.
+ *
+ * @param batch     - the ParsedDocuments containing the words to add, in order
+ * @param index     - a pointer reference to the IndexInterface with the PDF index
+ */
+void Parser::indexDocuments(std::vector<ParsedDocument*>& batch, IndexInterface*& index)
+{
+    std::vector<LocalIndex*> locals;
+    std::vector<uint32_t> ids;
+    std::vector<std::pair<int, int>> totals;
+
+    for(ParsedDocument* document : batch)
+    {
+        numPages += document->pages;
+        numWords += document->terms.getNumWords();
+
+        uint32_t id = documents.add(document->file);
+        documents.addWords(id, document->terms.getNumWords());
+        documents.addPages(id, document->pages);
+        if(document->first)
+            documents.setFileInfo(id, document->info);
+
+        locals.push_back(&document->terms);
+        ids.push_back(id);
+        totals.push_back(std::make_pair(numPages, numWords));
+    }
+
+    index->merge(locals, ids);
+
+    //Publish the totals once per document
+    for(size_t i{}; i < batch.size(); i++)
+    {
+        if(batch[i]->complete)
+            progress.fileParsed(batch[i]->file, batch[i]->parseTime,
+                                totals[i].first, totals[i].second);
+    }
+
+    //Let readers of the index see the new documents every so often
+    if(index->isPublished()
+            && std::chrono::steady_clock::now() - lastPublish
+               >= std::chrono::milliseconds(PUBLISH_INTERVAL_MS))
+        publish(index);
+}
+
+/**
+ *
+ * publish(IndexInterface*&)
+ *
+ * Publishes a snapshot of the index for the threads searching it, if the
+ * index has been published before. An index nothing reads from is never
+ * published, so it never pays for a snapshot.
+ *
+ * @param index - a pointer reference to the IndexInterface with the PDF index
+ */
+void Parser::publish(IndexInterface*& index)
+{
+    if(!index->isPublished())
+        return;
+
+    index->publish();
+    lastPublish = std::chrono::steady_clock::now();
+}
+
+/**
+ *
+ * countFiles(IndexInterface*&)
+ *
+ * Sets the number of files to the number of live documents. The idf of
+ * every word depends on it, so the index is given a new generation if it
+ * changed, and no result ranked against the old count is used again.
+ *
+ * @param index - a pointer reference to the IndexInterface with the PDF index
+ */
+void Parser::countFiles(IndexInterface*& index)
+{
+    int live = documents.getNumLive();
+    if(live == numFiles)
+        return;
+
+    numFiles = live;
+    index->bumpGeneration();
 }
 
 int Parser::getNumWords()
@@ -119,6 +377,16 @@ void Parser::setNumFiles(int value)
     numFiles = value;
 }
 
+int Parser::getNumThreads()
+{
+    return numThreads;
+}
+
+void Parser::setNumThreads(int value)
+{
+    numThreads = std::max(1, value);
+}
+
 
 /**
  *
@@ -138,169 +406,363 @@ bool Parser::isStopWord(std::string& word)
  *
  * invalidLength(std::string&)
  *
- * @param word  - the word to check
+ * @param word  - the UTF-8 word to check
  * @return      - true if the word is less than 3 letters long, false if not
  */
 bool Parser::invalidLength(std::string& word)
 {
-    return word.size() < 3;
+    return word.size() < 3 || Unicode::length(word) < 3;
 }
 
 /**
  *
- * parse(std::string, IndexInterface, int, int)
+ * parse(std::string, IndexInterface)
  *
- * Parses a directory and adds all words into the index interface,
- * providing an ncurses progress screen using the two int parameters
- * to delineate the size of the screen.
+ * Parses a directory and adds all words into the index interface. The
+ * progress of the parse is published through Parser::progress.
  *
  * @param directory - the directory to parse PDFs from
  * @param index     - the index to add words to
- * @param row       - the vertical size of the screen
- * @param col       - the horizontal size of the screen
  */
-void Parser::parse(std::string& directory, IndexInterface*& index,
-                   int row, int col)
+void Parser::parse(std::string& directory, IndexInterface*& index)
 {
     index->setIndexDirectory(directory);
     std::vector<std::string> files;
     numFiles = getFileList(directory, files);
-    directoryParser(files, index, row, col);
+    directoryParser(files, index);
+    publish(index);
 }
 
 
 /**
  *
- * directoryParser(vector<string>, IndexInterface, int, int)
+ * directoryParser(vector<string>, IndexInterface)
  *
  * Parses a directory and adds all words that are PDFs into the index,
- * using the row and column variables to provide a progress screen
- * that tells the user the number of words and files being parsed.
+ * publishing the number of files, pages, and words parsed and the average
+ * parse time through Parser::progress.
+ *
+ * If more than one thread is set through setNumThreads(), the PDFs are
+ * extracted by an IngestPool while this thread adds them to the index in
+ * the order of the file list, so the index is the same as a serial build.
+ * The pool splits large PDFs into ranges of pages that are read by several
+ * workers at once, and the parts are merged into the index MERGE_BATCH at
+ * a time. Either way, PDFs are read and inserted a part of a few pages at
+ * a time.
  *
  * @param files     - the list of files to parse
  * @param index     - the index to add words to
- * @param row       - the vertical size of the screen
- * @param col       - the horizontal size of the screen
  */
-void Parser::directoryParser(std::vector<std::string> files,
-                             IndexInterface*& index, int row, int col)
+void Parser::directoryParser(const std::vector<std::string>& files,
+                             IndexInterface*& index)
 {
     //Suppress all errors from poppler
     std::cerr.setstate(std::ios_base::failbit);
 
-    double averageTime;
-
-    for(int i{}; i < (int) files.size(); i++)
-    {
-
-        //Output current file
-        std::string currentFile = ("File " + std::to_string(i+1) + "/" + std::to_string((int) files.size()));
-        mvprintw(3, 5, currentFile.c_str());
+    progress.reset((int) files.size());
 
-        //Parse the current file
-        high_resolution_clock::time_point t1 = high_resolution_clock::now();
-        parseFile(files[i], index);
-        high_resolution_clock::time_point t2 = high_resolution_clock::now();
-        duration<double, std::milli> milliseconds = t2 - t1;
+    //Extract the documents on worker threads if more than one is used
+    IngestPool* pool{nullptr};
+    if(numThreads > 1)
+        pool = new IngestPool(files, numThreads);
 
-        //Output the average parsing time
-        averageTime = ((averageTime * i) + milliseconds.count()) / (i+1);
-        currentFile = ("Average Parse Time (ms): " + std::to_string(averageTime));
-        mvprintw(3, 65, currentFile.c_str());
+    if(pool != nullptr)
+    {
+        //Insert the parts of the documents in batches as they are handed back
+        std::vector<ParsedDocument> parts(MERGE_BATCH);
+        std::vector<ParsedDocument*> batch;
+        bool more{true};
+        while(more)
+        {
+            batch.clear();
+            while(batch.size() < parts.size() && (more = pool->next(parts[batch.size()])))
+                batch.push_back(&parts[batch.size()]);
 
-        //If the filename is long, truncate it.
-        if((int) files[i].size() > col - 25)
+            if(!batch.empty())
+                indexDocuments(batch, index);
+        }
+        delete pool;
+    }
+    else
+    {
+        for(const std::string& file : files)
         {
-            files[i].erase(col - 28, files[i].size());
-            files[i] = ("..." + files[i]);
+            std::string path{file};
+            parseFile(path, index);
         }
+    }
 
+    //Allow for errors again
+    std::cerr.clear();
+}
 
-        //Output for the stream of documents being parsed
-        int j{};
+/**
+ *
+ * addExtraDoc(std::string, IndexInterface)
+ *
+ * Parses a file and adds its elements to the IndexInterface. A file that
+ * is already in the index is skipped if it hasn't changed, and replaced
+ * if it has, so it is never counted twice.
+ *
+ * @param file      - the file to parse
+ * @param index     - the index to add the file's contents to
+ */
+void Parser::addExtraDoc(std::__cxx11::string& file, IndexInterface*& index)
+{
+    namespace fs = std::experimental::filesystem;
+    std::vector<std::string> changed;
+    std::vector<uint32_t> stale;
+    findChanges(std::vector<std::string>{fs::absolute(file)}, changed, stale);
+
+    removeDocuments(stale, index);
+    directoryParser(changed, index);
+    countFiles(index);
+    publish(index);
+}
+
+/**
+ *
+ * addExtraDirectory(std::string, IndexInterface)
+ *
+ * Uses the directoryParser() function to add an extra directory to the
+ * PDF IndexInterface given by the parameter. Only the files that are new
+ * or have changed since they were indexed are parsed.
+ *
+ * @param directory - the directory to parse
+ * @param index     - the index to add elements to
+ */
+void Parser::addExtraDirectory(std::__cxx11::string& directory,
+                               IndexInterface*& index)
+{
+    std::vector<std::string> files, changed;
+    std::vector<uint32_t> stale;
+    getFileList(directory, files);
+    findChanges(files, changed, stale);
+
+    removeDocuments(stale, index);
+    directoryParser(changed, index);
+    countFiles(index);
+    publish(index);
+}
+
+/**
+ *
+ * refresh(std::string, IndexInterface)
+ *
+ * Brings the index up to date with the files on disk. Every document in
+ * the manifest is checked against its file: documents whose files have
+ * been deleted are removed, and documents whose files have changed are
+ * removed and parsed again. PDFs in the directory that aren't in the
+ * index yet are parsed and added. Unchanged files are never opened, so a
+ * refresh takes time in proportion to what has changed.
+ *
+ * @param directory - the directory to search for new PDFs
+ * @param index     - the index to bring up to date
+ */
+void Parser::refresh(std::string& directory, IndexInterface*& index)
+{
+    std::vector<std::string> changed;
+    std::vector<uint32_t> stale;
 
-        //Sets bottom of document stream
-        if(i - (3 * row / 4) > 0)
-            j = i - (3 * row / 4);
+    //Check every document in the manifest against its file
+    for(uint32_t id{}; id < (uint32_t) documents.size(); id++)
+    {
+        if(documents.isRemoved(id))
+            continue;
 
-        for(;j < i+1; j++)
+        FileInfo info;
+        if(!FileInfo::stat(documents.getPath(id), info))
+            stale.push_back(id);
+        else if(!isUnchanged(id, info))
         {
-            //Outputs the document
-            for(int k{}; k < col - 2; k++)
-            {
-                mvaddch(5 + (i + 1 - j), 8 + k, ' ');
-            }
-            mvaddch(5 + (i + 1 - j), col - 2, '*');
-            mvprintw(5 + (i + 1 - j), 8, files[j].c_str());
-            refresh();
+            stale.push_back(id);
+            changed.push_back(documents.getPath(id));
+        }
+    }
 
+    //Find the PDFs that were added to the directory
+    std::vector<std::string> files;
+    getFileList(directory, files);
+    for(const std::string& file : files)
+    {
+        if(documents.find(file) == -1)
+            changed.push_back(file);
+    }
 
-            //Clears each line so that the stream can be repopulated
-            for(int k{col - 25}; k <col - 2; k++)
-            {
-                mvaddch(5 + (i + 1 - j), 8 + k, ' ');
-            }
-            mvaddch(5 + (i + 1 - j), col - 2, '*');
-            refresh();
+    removeDocuments(stale, index);
+    directoryParser(changed, index);
+    countFiles(index);
+    publish(index);
+}
 
+/**
+ *
+ * isUnchanged(uint32_t, FileInfo&)
+ *
+ * Compares a file with its entry in the manifest. If its size and
+ * modification time match, it is unchanged. If only the modification time
+ * differs, the file is hashed, and if the hash matches, the manifest is
+ * updated with the new time instead of the file being parsed again.
+ *
+ * @param id    - the ID of the document in the DocumentTable
+ * @param info  - the size and modification time of the file now, which
+ *                is given its hash if one is needed
+ * @return      - true if the contents of the file are unchanged, false if not
+ */
+bool Parser::isUnchanged(uint32_t id, FileInfo& info)
+{
+    const FileInfo& indexed = documents.getFileInfo(id);
+    if(info.size != indexed.size)
+        return false;
+    if(info.modifiedTime == indexed.modifiedTime)
+        return true;
+
+    info.contentHash = FileInfo::hash(documents.getPath(id));
+    if(info.contentHash != indexed.contentHash)
+        return false;
+
+    documents.setFileInfo(id, info);
+    return true;
+}
+
+/**
+ *
+ * findChanges(vector<string>, vector<string>, vector<uint32_t>)
+ *
+ * Sorts a list of files into those that must be parsed, because they are
+ * new or have changed, and the documents those changes make stale. The
+ * documents of files that no longer exist are stale too.
+ *
+ * @param files     - the files to check
+ * @param changed   - the list to add files that are new or have changed to
+ * @param stale     - the list to add the IDs of documents that have changed
+ *                    or been deleted to
+ */
+void Parser::findChanges(const std::vector<std::string>& files,
+                         std::vector<std::string>& changed,
+                         std::vector<uint32_t>& stale)
+{
+    for(const std::string& file : files)
+    {
+        int64_t id = documents.find(file);
+        FileInfo info;
+        if(id == -1)
+            changed.push_back(file);
+        else if(!FileInfo::stat(file, info))
+            stale.push_back(id);
+        else if(!isUnchanged(id, info))
+        {
+            stale.push_back(id);
+            changed.push_back(file);
         }
+    }
+}
 
-        refresh();
+/**
+ *
+ * removeDocuments(vector<uint32_t>, IndexInterface)
+ *
+ * Removes documents from the index. Each document only has its words and
+ * pages taken off the counters and is marked as removed in the
+ * DocumentTable, which leaves a tombstone in place of its postings, so
+ * removing a document takes constant time no matter how many words it
+ * has. The postings are compacted away once the tombstones make up more
+ * than MAX_TOMBSTONE_RATIO of the documents. The index is given a new
+ * generation, since the results of queries change.
+ *
+ * @param ids       - the IDs of the documents to remove
+ * @param index     - the index to remove the documents from
+ */
+void Parser::removeDocuments(std::vector<uint32_t>& ids, IndexInterface*& index)
+{
+    for(uint32_t id : ids)
+    {
+        if(documents.isRemoved(id))
+            continue;
 
+        numWords -= documents.getWordCount(id);
+        numPages -= documents.getPageCount(id);
+        documents.remove(id);
     }
-    //Allow for errors again
-    std::cerr.clear();
+    countFiles(index);
+    index->bumpGeneration();
 
-    //Recalculate all ranks of the words
-    index->recalculateRanking();
+    if(documents.getTombstones().size() > MAX_TOMBSTONE_RATIO * documents.getNumLive())
+        index->compact();
 }
 
 /**
  *
- * addExtraDoc(std::string, IndexInterface)
+ * removeDocument(const std::string&, IndexInterface)
  *
- * Parses a file and adds its elements to the IndexInterface, calling
- * the parseFile() function.
+ * Removes a single document from the index, leaving a tombstone in place
+ * of its postings. A relative path is made absolute first, as the paths of
+ * documents are when they are added.
  *
- * @param file      - the file to parse
- * @param index     - the index to add the file's contents to
+ * @param file      - the path of the document
+ * @param index     - the index to remove the document from
+ * @return          - true if the document was in the index, false if not
  */
-void Parser::addExtraDoc(std::__cxx11::string& file, IndexInterface*& index)
+bool Parser::removeDocument(const std::string& file, IndexInterface*& index)
 {
-    numFiles++;
-    parseFile(file, index);
-    index->recalculateRanking();
+    int64_t id = documents.find(std::experimental::filesystem::absolute(file));
+    if(id == -1)
+        return false;
+
+    std::vector<uint32_t> ids{(uint32_t) id};
+    removeDocuments(ids, index);
+    publish(index);
+    return true;
 }
 
 /**
  *
- * addExtraDirectory(std::string, IndexInterface, int, int)
+ * updateDocument(std::string, IndexInterface)
  *
- * Uses the directoryParser() function to add an extra directory to the
- * PDF IndexInterface given by the parameter.
+ * Replaces a document with the current contents of its file. The old
+ * document is removed, leaving a tombstone, and the file is parsed again
+ * under a new ID. If the file no longer exists, the document is only
+ * removed. A relative path is made absolute first, so the old document is
+ * found rather than indexed a second time.
  *
- * @param directory - the directory to parse
- * @param index     - the index to add elements to
- * @param row       - the vertical size of the screen
- * @param col       - the horizontal size of the screen
+ * @param file      - the path of the document
+ * @param index     - the index to update
  */
-void Parser::addExtraDirectory(std::__cxx11::string& directory,
-                               IndexInterface*& index, int row, int col)
+void Parser::updateDocument(std::string& file, IndexInterface*& index)
 {
+    namespace fs = std::experimental::filesystem;
+    std::string path = fs::absolute(file);
+
+    //The old document isn't published on its own, so readers never miss it
+    int64_t id = documents.find(path);
+    std::vector<uint32_t> ids;
+    if(id != -1)
+        ids.push_back(id);
+    removeDocuments(ids, index);
+
     std::vector<std::string> files;
-    numFiles += getFileList(directory, files);
-    directoryParser(files, index, row, col);
-    index->recalculateRanking();
+    if(fs::exists(path))
+        files.push_back(path);
+
+    directoryParser(files, index);
+    countFiles(index);
+    publish(index);
 }
 
 
-std::unordered_map<std::string, int> Parser::totalWordsInDoc{};
+DocumentTable Parser::documents{};
 int Parser::numFiles{0};
 bool Parser::extraFiles{false};
 int Parser::numWords{0};
 int Parser::numPages{0};
-
-poppler::rectf Parser::rectangle{poppler::rectf(0, 0, 500, 500)};
+ParseProgress Parser::progress{};
+int Parser::numThreads{(int) std::max(1u, std::thread::hardware_concurrency())};
+
+const size_t Parser::STEM_CACHE_SIZE;
+const int Parser::MERGE_BATCH;
+const int Parser::PUBLISH_INTERVAL_MS;
+std::chrono::steady_clock::time_point Parser::lastPublish{};
+constexpr double Parser::MAX_TOMBSTONE_RATIO;
 
 std::unordered_set<std::string> Parser::stopwords
 {"new","its", "why", "www", "let", "hed",
@@ -5,18 +5,19 @@
 #include <unordered_map>
 #include <string>
 #include <experimental/filesystem>
-#include <poppler/cpp/poppler-document.h>
-#include <poppler/cpp/poppler-page.h>
-#include <poppler/cpp/poppler-rectangle.h>
 #include <stemmer.h>
 #include <chrono>
 #include <sstream>
+#include <array>
 #include <iostream>
 #include <iomanip>
 #include <Index/indexinterface.h>
-#include <ncurses.h>
 #include <list>
 #include <cstdlib>
+#include <thread>
+#include <Parser/parseddocument.h>
+#include <Parser/documenttable.h>
+#include <Parser/parseprogress.h>
 
 class IndexInterface;
 
@@ -29,6 +30,12 @@ class IndexInterface;
  * also keeps track of the total number of files, words, and pages parsed,
  * as well as a table of documents and their respective word counts.
  *
+ * The table of documents doubles as a manifest of the files that were
+ * parsed, so an index can be refreshed by parsing only the files that are
+ * new or have changed, and removing the documents of deleted files.
+ * Removed documents are left as tombstones, whose postings are compacted
+ * away later.
+ *
  * NOTE: The word counts are the counts of words that have been parsed,
  *       which does not include words shorter than 3, or stop words.
  *
@@ -42,34 +49,76 @@ class Parser
         //Stopword list
         static std::unordered_set<std::string> stopwords;
 
-        //Gets maximum possible size for PDF to capture all data
-        static poppler::rectf rectangle;
+        //Maximum number of words in the stem cache of each thread
+        static const size_t STEM_CACHE_SIZE = 100000;
+
+        //Milliseconds between the snapshots published while documents are inserted
+        static const int PUBLISH_INTERVAL_MS = 1000;
+
+        //Time the last snapshot of the index was published
+        static std::chrono::steady_clock::time_point lastPublish;
+
+        //Fraction of the documents that may be tombstones before the index is compacted
+        static constexpr double MAX_TOMBSTONE_RATIO = 0.125;
 
         //Steps 1 & 2 of parsing files and developing index
-        static int getFileList(std::string directory, std::vector<std::string>& files);
         static void parseFile(std::string& file, IndexInterface*& index);
 
+        //Stem a word and add it to the words of a document
+        static void addWord(std::string& str, bool ideograph, std::vector<std::string>& words);
+
+        //Publish a snapshot of the index, if it has been published before
+        static void publish(IndexInterface*& index);
+
+        //Count the live documents, giving the index a new generation if the count changed
+        static void countFiles(IndexInterface*& index);
+
+        //Change detection against the manifest in the table of documents
+        static bool isUnchanged(uint32_t id, FileInfo& info);
+        static void findChanges(const std::vector<std::string>& files,
+                                std::vector<std::string>& changed,
+                                std::vector<uint32_t>& stale);
+
     public:
 
-        //Counters for files, words, pages, and table for doc-wordount
+        //Counters for files, words, pages, and table of documents
         static int numFiles;
         static bool extraFiles;
         static int numWords;
         static int numPages;
-        static std::unordered_map<std::string, int> totalWordsInDoc;
+        static DocumentTable documents;
+
+        //Number of threads used to parse a directory
+        static int numThreads;
+
+        //Number of parts of documents merged into the index at once
+        static const int MERGE_BATCH = 32;
+
+        //Progress of the current parse, for display on another thread
+        static ParseProgress progress;
 
         //Checking validity of words
         static bool isStopWord(std::string& word);
         static bool invalidLength(std::string& word);
 
         //Parsing functions
-        static void parse(std::string& directory,
-                          IndexInterface*& index, int row, int col);
+        static int getFileList(std::string directory, std::vector<std::string>& files);
+        static void tokenize(const std::string& text, std::vector<std::string>& words);
+        static void tokenize(const char* text, size_t length, std::vector<std::string>& words);
+        static void indexDocument(ParsedDocument& document, IndexInterface*& index);
+        static void indexDocuments(std::vector<ParsedDocument*>& batch, IndexInterface*& index);
+        static void parse(std::string& directory, IndexInterface*& index);
         static void addExtraDoc(std::string& file, IndexInterface*& index);
         static void addExtraDirectory(std::string& directory,
-                                      IndexInterface*& index, int row, int col);
-        static void directoryParser(std::vector<std::__cxx11::string> files,
-                                    IndexInterface*&index, int row, int col);
+                                      IndexInterface*& index);
+        static void directoryParser(const std::vector<std::__cxx11::string>& files,
+                                    IndexInterface*&index);
+
+        //Incremental updates
+        static void refresh(std::string& directory, IndexInterface*& index);
+        static bool removeDocument(const std::string& file, IndexInterface*& index);
+        static void updateDocument(std::string& file, IndexInterface*& index);
+        static void removeDocuments(std::vector<uint32_t>& ids, IndexInterface*& index);
 
         //Getters and setters
         static int getNumFiles();
@@ -78,6 +127,8 @@ class Parser
         static void setNumPages(int value);
         static int getNumWords();
         static void setNumWords(int value);
+        static int getNumThreads();
+        static void setNumThreads(int value);
 };
 
 
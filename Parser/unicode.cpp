@@ -0,0 +1,347 @@
+#include <Parser/unicode.h>
+
+#include <algorithm>
+#include <iterator>
+#include <cctype>
+
+const uint32_t Unicode::REPLACEMENT;
+
+/**
+ * A range of code points that belong to words. Combining marks are
+ * included, so accents written as separate characters stay in the word.
+ */
+struct WordRange
+{
+    uint32_t first;
+    uint32_t last;
+    Unicode::CharType type;
+};
+
+static const WordRange wordRanges[] =
+{
+    {0x00AA, 0x00AA, Unicode::LETTER},      //Ordinal indicators and micro sign
+    {0x00B5, 0x00B5, Unicode::LETTER},
+    {0x00BA, 0x00BA, Unicode::LETTER},
+    {0x00C0, 0x00D6, Unicode::LETTER},      //Latin-1 letters
+    {0x00D8, 0x00F6, Unicode::LETTER},
+    {0x00F8, 0x02AF, Unicode::LETTER},      //Latin Extended and IPA
+    {0x0300, 0x036F, Unicode::LETTER},      //Combining diacritical marks
+    {0x0370, 0x0373, Unicode::LETTER},      //Greek and Coptic
+    {0x0376, 0x0377, Unicode::LETTER},
+    {0x037A, 0x037D, Unicode::LETTER},
+    {0x037F, 0x037F, Unicode::LETTER},
+    {0x0386, 0x0386, Unicode::LETTER},
+    {0x0388, 0x038A, Unicode::LETTER},
+    {0x038C, 0x038C, Unicode::LETTER},
+    {0x038E, 0x03A1, Unicode::LETTER},
+    {0x03A3, 0x03F5, Unicode::LETTER},
+    {0x03F7, 0x0481, Unicode::LETTER},      //Cyrillic
+    {0x0483, 0x052F, Unicode::LETTER},
+    {0x0531, 0x0556, Unicode::LETTER},      //Armenian
+    {0x0561, 0x0587, Unicode::LETTER},
+    {0x0591, 0x05BD, Unicode::LETTER},      //Hebrew
+    {0x05BF, 0x05BF, Unicode::LETTER},
+    {0x05C1, 0x05C2, Unicode::LETTER},
+    {0x05C4, 0x05C5, Unicode::LETTER},
+    {0x05C7, 0x05C7, Unicode::LETTER},
+    {0x05D0, 0x05EA, Unicode::LETTER},
+    {0x0610, 0x061A, Unicode::LETTER},      //Arabic
+    {0x0620, 0x065F, Unicode::LETTER},
+    {0x066E, 0x06D3, Unicode::LETTER},
+    {0x0900, 0x0963, Unicode::LETTER},      //Devanagari
+    {0x0971, 0x097F, Unicode::LETTER},
+    {0x0E01, 0x0E3A, Unicode::LETTER},      //Thai
+    {0x0E40, 0x0E4E, Unicode::LETTER},
+    {0x10A0, 0x10C5, Unicode::LETTER},      //Georgian
+    {0x10D0, 0x10FF, Unicode::LETTER},
+    {0x1100, 0x11FF, Unicode::LETTER},      //Hangul Jamo
+    {0x1E00, 0x1FBC, Unicode::LETTER},      //Latin Extended Additional and Greek Extended
+    {0x1FBE, 0x1FBE, Unicode::LETTER},
+    {0x1FC2, 0x1FCC, Unicode::LETTER},
+    {0x1FD0, 0x1FDB, Unicode::LETTER},
+    {0x1FE0, 0x1FEC, Unicode::LETTER},
+    {0x1FF2, 0x1FFC, Unicode::LETTER},
+    {0x2D00, 0x2D25, Unicode::LETTER},      //Georgian Supplement
+    {0x3005, 0x3007, Unicode::IDEOGRAPH},   //Ideographic iteration marks
+    {0x3041, 0x3096, Unicode::IDEOGRAPH},   //Hiragana
+    {0x309D, 0x309F, Unicode::IDEOGRAPH},
+    {0x30A1, 0x30FA, Unicode::IDEOGRAPH},   //Katakana
+    {0x30FC, 0x30FF, Unicode::IDEOGRAPH},
+    {0x3400, 0x4DBF, Unicode::IDEOGRAPH},   //CJK Unified Ideographs
+    {0x4E00, 0x9FFF, Unicode::IDEOGRAPH},
+    {0xAC00, 0xD7A3, Unicode::LETTER},      //Hangul Syllables
+    {0xF900, 0xFAFF, Unicode::IDEOGRAPH},   //CJK Compatibility Ideographs
+    {0xFB00, 0xFB06, Unicode::LETTER},      //Latin ligatures
+    {0xFF21, 0xFF3A, Unicode::LETTER},      //Fullwidth Latin letters
+    {0xFF41, 0xFF5A, Unicode::LETTER},
+    {0xFF66, 0xFF9D, Unicode::IDEOGRAPH},   //Halfwidth Katakana
+    {0x20000, 0x2FA1F, Unicode::IDEOGRAPH}  //CJK Extensions
+};
+
+/**
+ * A range of uppercase letters and the distance to their lowercase letters.
+ * In many blocks, the uppercase and lowercase letters alternate, so only
+ * the letters at even or odd code points are folded.
+ */
+struct CaseRange
+{
+    enum Parity { ALL, EVEN, ODD };
+
+    uint32_t first;
+    uint32_t last;
+    int32_t delta;
+    Parity parity;
+};
+
+static const CaseRange caseRanges[] =
+{
+    {0x00C0, 0x00D6, 32, CaseRange::ALL},
+    {0x00D8, 0x00DE, 32, CaseRange::ALL},
+    {0x0100, 0x012F, 1, CaseRange::EVEN},
+    {0x0134, 0x0137, 1, CaseRange::EVEN},
+    {0x0139, 0x0148, 1, CaseRange::ODD},
+    {0x014A, 0x0177, 1, CaseRange::EVEN},
+    {0x0178, 0x0178, 0x00FF - 0x0178, CaseRange::ALL},
+    {0x0179, 0x017E, 1, CaseRange::ODD},
+    {0x01CD, 0x01DC, 1, CaseRange::ODD},
+    {0x01DE, 0x01EF, 1, CaseRange::EVEN},
+    {0x01F8, 0x021F, 1, CaseRange::EVEN},
+    {0x0222, 0x0233, 1, CaseRange::EVEN},
+    {0x0386, 0x0386, 38, CaseRange::ALL},
+    {0x0388, 0x038A, 37, CaseRange::ALL},
+    {0x038C, 0x038C, 64, CaseRange::ALL},
+    {0x038E, 0x038F, 63, CaseRange::ALL},
+    {0x0391, 0x03A1, 32, CaseRange::ALL},
+    {0x03A3, 0x03AB, 32, CaseRange::ALL},
+    {0x03C2, 0x03C2, 1, CaseRange::ALL},    //Final sigma
+    {0x03D8, 0x03EF, 1, CaseRange::EVEN},
+    {0x0400, 0x040F, 80, CaseRange::ALL},
+    {0x0410, 0x042F, 32, CaseRange::ALL},
+    {0x0460, 0x0481, 1, CaseRange::EVEN},
+    {0x048A, 0x04BF, 1, CaseRange::EVEN},
+    {0x04C0, 0x04C0, 15, CaseRange::ALL},
+    {0x04C1, 0x04CE, 1, CaseRange::ODD},
+    {0x04D0, 0x052F, 1, CaseRange::EVEN},
+    {0x0531, 0x0556, 48, CaseRange::ALL},
+    {0x10A0, 0x10C5, 0x2D00 - 0x10A0, CaseRange::ALL},
+    {0x1E00, 0x1E95, 1, CaseRange::EVEN},
+    {0x1EA0, 0x1EFF, 1, CaseRange::EVEN},
+    {0xFF21, 0xFF3A, 'a' - 0xFF21, CaseRange::ALL},
+    {0xFF41, 0xFF5A, 'a' - 0xFF41, CaseRange::ALL}
+};
+
+/**
+ * A letter that is replaced by a string of letters when it is folded.
+ */
+struct Expansion
+{
+    uint32_t codePoint;
+    const char* replacement;
+};
+
+static const Expansion expansions[] =
+{
+    {0x00AA, "a"},
+    {0x00B5, "\xCE\xBC"},                   //Micro sign to mu
+    {0x00BA, "o"},
+    {0x00DF, "ss"},
+    {0x0130, "i"},
+    {0x0132, "ij"},
+    {0x0133, "ij"},
+    {0x017F, "s"},
+    {0x1E9E, "ss"},
+    {0xFB00, "ff"},
+    {0xFB01, "fi"},
+    {0xFB02, "fl"},
+    {0xFB03, "ffi"},
+    {0xFB04, "ffl"},
+    {0xFB05, "st"},
+    {0xFB06, "st"}
+};
+
+/**
+ *
+ * decode(const char*&, const char*)
+ *
+ * Decodes the UTF-8 character at the iterator and moves the iterator past
+ * it. Invalid or truncated sequences, overlong encodings, and surrogates
+ * decode to REPLACEMENT, skipping a single byte.
+ *
+ * @param it    - the iterator pointing to the first byte of the character
+ * @param end   - the end of the text
+ * @return      - the code point of the character
+ */
+uint32_t Unicode::decode(const char*& it, const char* end)
+{
+    unsigned char lead = *it++;
+    if(lead < 0x80)
+        return lead;
+
+    int length;
+    uint32_t codePoint, minimum;
+    if((lead & 0xE0) == 0xC0)
+    {
+        length = 1;
+        codePoint = lead & 0x1F;
+        minimum = 0x80;
+    }
+    else if((lead & 0xF0) == 0xE0)
+    {
+        length = 2;
+        codePoint = lead & 0x0F;
+        minimum = 0x800;
+    }
+    else if((lead & 0xF8) == 0xF0)
+    {
+        length = 3;
+        codePoint = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else
+    {
+        return REPLACEMENT;
+    }
+
+    if(end - it < length)
+        return REPLACEMENT;
+
+    for(int i{}; i < length; i++)
+    {
+        unsigned char c = it[i];
+        if((c & 0xC0) != 0x80)
+            return REPLACEMENT;
+        codePoint = (codePoint << 6) | (c & 0x3F);
+    }
+
+    if(codePoint < minimum || codePoint > 0x10FFFF
+            || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+        return REPLACEMENT;
+
+    it += length;
+    return codePoint;
+}
+
+/**
+ *
+ * encode(uint32_t, std::string&)
+ *
+ * @param codePoint - the code point to encode
+ * @param str       - the string to append the UTF-8 encoding to
+ */
+void Unicode::encode(uint32_t codePoint, std::string& str)
+{
+    if(codePoint < 0x80)
+    {
+        str += (char) codePoint;
+    }
+    else if(codePoint < 0x800)
+    {
+        str += (char) (0xC0 | (codePoint >> 6));
+        str += (char) (0x80 | (codePoint & 0x3F));
+    }
+    else if(codePoint < 0x10000)
+    {
+        str += (char) (0xE0 | (codePoint >> 12));
+        str += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        str += (char) (0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        str += (char) (0xF0 | (codePoint >> 18));
+        str += (char) (0x80 | ((codePoint >> 12) & 0x3F));
+        str += (char) (0x80 | ((codePoint >> 6) & 0x3F));
+        str += (char) (0x80 | (codePoint & 0x3F));
+    }
+}
+
+/**
+ *
+ * classify(uint32_t)
+ *
+ * @param codePoint - the code point to classify
+ * @return          - LETTER if the character is part of a word, IDEOGRAPH
+ *                    if it is a word on its own, and SEPARATOR otherwise
+ */
+Unicode::CharType Unicode::classify(uint32_t codePoint)
+{
+    if(codePoint < 0x80)
+        return std::isalpha(codePoint) ? LETTER : SEPARATOR;
+
+    //Find the last range starting at or before the code point
+    const WordRange* range = std::upper_bound(std::begin(wordRanges), std::end(wordRanges), codePoint,
+                                              [](uint32_t cp, const WordRange& r) { return cp < r.first; });
+    if(range == std::begin(wordRanges) || codePoint > (--range)->last)
+        return SEPARATOR;
+
+    return range->type;
+}
+
+/**
+ *
+ * appendFolded(uint32_t, std::string&)
+ *
+ * Appends the normalized, lowercase form of a letter to the string.
+ * Ligatures and other compatibility characters are replaced by the letters
+ * they stand for, and uppercase letters are replaced by their lowercase
+ * letters. Any other letter is appended unchanged.
+ *
+ * @param codePoint - the letter to fold
+ * @param str       - the string to append the folded letter to
+ */
+void Unicode::appendFolded(uint32_t codePoint, std::string& str)
+{
+    if(codePoint < 0x80)
+    {
+        str += (char) std::tolower(codePoint);
+        return;
+    }
+
+    const Expansion* expansion = std::lower_bound(std::begin(expansions), std::end(expansions), codePoint,
+                                                  [](const Expansion& e, uint32_t cp) { return e.codePoint < cp; });
+    if(expansion != std::end(expansions) && expansion->codePoint == codePoint)
+    {
+        str += expansion->replacement;
+        return;
+    }
+
+    const CaseRange* range = std::upper_bound(std::begin(caseRanges), std::end(caseRanges), codePoint,
+                                              [](uint32_t cp, const CaseRange& r) { return cp < r.first; });
+    if(range != std::begin(caseRanges) && codePoint <= (--range)->last)
+    {
+        if(range->parity == CaseRange::ALL
+                || (range->parity == CaseRange::EVEN) == (codePoint % 2 == 0))
+            codePoint += range->delta;
+    }
+
+    encode(codePoint, str);
+}
+
+/**
+ * length(const std::string&)
+ *
+ * @param str   - a UTF-8 string
+ * @return      - the number of code points within the string
+ */
+int Unicode::length(const std::string& str)
+{
+    int count{};
+    for(unsigned char c : str)
+        count += (c & 0xC0) != 0x80;
+    return count;
+}
+
+/**
+ * isAscii(const std::string&)
+ *
+ * @param str   - a UTF-8 string
+ * @return      - true if every character is ASCII, false if not
+ */
+bool Unicode::isAscii(const std::string& str)
+{
+    for(unsigned char c : str)
+    {
+        if(c >= 0x80)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+/**
+ * The Unicode class is a static class that contains the character
+ * handling the tokenizer needs for UTF-8 text: decoding and encoding
+ * UTF-8, deciding which characters belong to words, and normalizing
+ * letters so that the same word is always indexed the same way.
+ *
+ * Normalization folds uppercase letters to lowercase, and replaces the
+ * compatibility characters NFKC would replace, such as the ligature "ﬁ"
+ * and fullwidth letters, with the letters they stand for. The tables
+ * cover the Latin, Greek, Cyrillic, Armenian, and Georgian alphabets.
+ * Other scripts are kept as they are.
+ *
+ * Han ideographs and Japanese kana are not separated by spaces, so each
+ * of them is treated as a word of its own.
+ *
+ * By: Oisin Coveney
+ */
+class Unicode
+{
+    public:
+
+        //Types of characters within text
+        enum CharType { SEPARATOR, LETTER, IDEOGRAPH };
+
+        //Code point used in place of invalid UTF-8
+        static const uint32_t REPLACEMENT = 0xFFFD;
+
+        //Decode the code point at the iterator, moving past it
+        static uint32_t decode(const char*& it, const char* end);
+
+        //Append the UTF-8 encoding of a code point to a string
+        static void encode(uint32_t codePoint, std::string& str);
+
+        //Get whether a code point is part of a word
+        static CharType classify(uint32_t codePoint);
+
+        //Append the normalized, lowercase form of a letter to a string
+        static void appendFolded(uint32_t codePoint, std::string& str);
+
+        //Get the number of code points within a UTF-8 string
+        static int length(const std::string& str);
+
+        //Check if a string only contains ASCII characters
+        static bool isAscii(const std::string& str);
+};
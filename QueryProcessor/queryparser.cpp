@@ -0,0 +1,290 @@
+#include <QueryProcessor/queryparser.h>
+#include <Parser/parser.h>
+
+#include <sstream>
+
+const int QueryParser::MAX_DEPTH;
+
+/**
+ * Destructor
+ */
+QueryNode::~QueryNode()
+{
+    for(QueryNode* child : children)
+        delete child;
+}
+
+/**
+ *
+ * QueryParser(const std::string&, std::vector<std::string>*)
+ *
+ * Splits a query into tokens at whitespace, with every parenthesis a token
+ * of its own.
+ *
+ * @param query     - the query to parse
+ * @param warnings  - the list to add warnings to, or nullptr
+ */
+QueryParser::QueryParser(const std::string& query, std::vector<std::string>* warnings)
+    : tokens{}, next{0}, warnings{warnings}, ignored{0},
+      unclosed{false}, tooDeep{false}, mixed{false}
+{
+    std::stringstream queryStream(query);
+    std::string token;
+    while(queryStream >> token)
+    {
+        std::string word;
+        for(char c : token)
+        {
+            if(c == '(' || c == ')')
+            {
+                if(!word.empty())
+                    tokens.push_back(word);
+                tokens.push_back(std::string(1, c));
+                word.clear();
+            }
+            else
+                word += c;
+        }
+        if(!word.empty())
+            tokens.push_back(word);
+    }
+}
+
+/**
+ *
+ * parse(const std::string&, std::vector<std::string>*)
+ *
+ * Parses a query into a tree of QueryNodes, which the caller must delete.
+ * A warning is added for every word, operator, and parenthesis that is
+ * left out, and for a query that mixes AND and OR without parentheses.
+ *
+ * @param query     - a boolean query
+ * @param warnings  - the list to add warnings to, or nullptr
+ * @return          - the root of the tree, or nullptr if the query has no operands
+ */
+QueryNode* QueryParser::parse(const std::string& query, std::vector<std::string>* warnings)
+{
+    QueryParser parser{query, warnings};
+    QueryNode* root = parser.parseSequence(0);
+
+    if(parser.unclosed)
+        parser.warn("An opening parenthesis is not closed, so it has been closed"
+                    " at the end of the query.");
+    if(parser.tooDeep)
+        parser.warn("Parentheses nested more than " + std::to_string(MAX_DEPTH)
+                    + " deep have been ignored.");
+    if(parser.mixed)
+        parser.warn("The query mixes AND and OR without parentheses. Operators are"
+                    " applied from left to right, so \"a OR b AND c\" is searched as"
+                    " \"(a OR b) AND c\". Use parentheses to group the words otherwise.");
+    return root;
+}
+
+/**
+ *
+ * parseSequence(int)
+ *
+ * Parses operands and operators, putting each operand together with the
+ * ones before it using the last operator read, or OR before the first.
+ * Inside parentheses, the sequence ends at the closing parenthesis, which
+ * is read; at the top level, closing parentheses are skipped.
+ *
+ * @param depth - the number of parentheses the sequence is within
+ * @return      - the operands put together, or nullptr if there are none
+ */
+QueryNode* QueryParser::parseSequence(int depth)
+{
+    QueryNode* current{nullptr};
+    QueryNode::Type operation{QueryNode::OR};
+
+    //The last operator, until an operand follows it, and whether AND and OR were used
+    std::string dangling;
+    bool usedAnd{false}, usedOr{false};
+    bool closed{false};
+    while(next < tokens.size())
+    {
+        const std::string& token = tokens[next++];
+        if(token == ")")
+        {
+            if(ignored > 0)
+                ignored--;
+            else if(depth > 0)
+            {
+                closed = true;
+                break;
+            }
+            else
+                warn("A closing parenthesis has no opening parenthesis, so it has been ignored.");
+        }
+        else if(token == "AND" || token == "OR" || token == "NOT")
+        {
+            warnDangling(dangling);
+            dangling = token;
+            usedAnd = usedAnd || token == "AND";
+            usedOr = usedOr || token == "OR";
+            operation = (token == "AND") ? QueryNode::AND
+                      : (token == "OR") ? QueryNode::OR : QueryNode::NOT;
+        }
+        else
+        {
+            dangling.clear();
+            QueryNode* operand = parseOperand(token, depth);
+            if(operand == nullptr)
+                continue;
+
+            //There is nothing to take the documents of the operand from
+            if(current == nullptr && operation == QueryNode::NOT)
+            {
+                warn((token == "(" ? std::string{"The words in parentheses follow"}
+                                   : "The word \"" + token + "\" follows")
+                     + " a NOT with nothing before it to take documents from, so "
+                     + (token == "(" ? "they" : "it") + " will be omitted from the search.");
+                delete operand;
+                continue;
+            }
+
+            //Words before the first operator are put together with OR
+            usedOr = usedOr || (current != nullptr && operation == QueryNode::OR);
+            current = apply(current, operation, operand);
+        }
+    }
+    warnDangling(dangling);
+
+    unclosed = unclosed || (depth > 0 && !closed);
+    mixed = mixed || (usedAnd && usedOr);
+    return current;
+}
+
+/**
+ *
+ * parseOperand(const std::string&, int)
+ *
+ * Parses the group that follows an opening parenthesis, or stems a word.
+ *
+ * @param token - the token the operand starts with
+ * @param depth - the number of parentheses the operand is within
+ * @return      - the operand, or nullptr if it is an empty group, a word
+ *                that is left out, or a parenthesis nested too deep
+ */
+QueryNode* QueryParser::parseOperand(const std::string& token, int depth)
+{
+    if(token == "(" && depth >= MAX_DEPTH)
+    {
+        ignored++;
+        tooDeep = true;
+        return nullptr;
+    }
+    if(token == "(")
+    {
+        QueryNode* group = parseSequence(depth + 1);
+        if(group != nullptr)
+            group->grouped = true;
+        return group;
+    }
+
+    //Normalizes and stems the word the same way as the documents
+    QueryNode* term = new QueryNode(QueryNode::TERM);
+    Parser::tokenize(token, term->terms);
+    if(term->terms.empty())
+    {
+        std::string word{token};
+        if(Parser::invalidLength(word))
+            warn("The word \"" + token + "\" is too short and has been deemed"
+                 " irrelevant to the search. The word will be omitted from the search.");
+        else
+            warn("The word \"" + token + "\" is a common word that has been deemed"
+                 " irrelevant to the search. The word will be omitted from the search.");
+        delete term;
+        return nullptr;
+    }
+    return term;
+}
+
+/**
+ *
+ * apply(QueryNode*, QueryNode::Type, QueryNode*)
+ *
+ * Puts an operand together with the operands before it. An operand joins
+ * the node of the operands before it if that node has the same operation
+ * and wasn't written within parentheses; otherwise the operands before it
+ * become the first operand of a new node.
+ *
+ * @param current   - the operands before, or nullptr if there are none
+ * @param operation - the operation to apply, which isn't NOT if there are
+ *                    no operands before
+ * @param operand   - the operand to add
+ * @return          - the operands put together
+ */
+QueryNode* QueryParser::apply(QueryNode* current, QueryNode::Type operation, QueryNode* operand)
+{
+    if(current == nullptr)
+        return operand;
+
+    if(current->type == operation && !current->grouped)
+    {
+        current->children.push_back(operand);
+        return current;
+    }
+
+    QueryNode* node = new QueryNode(operation);
+    node->children.push_back(current);
+    node->children.push_back(operand);
+    return node;
+}
+
+/**
+ *
+ * warn(const std::string&)
+ *
+ * @param message   - the warning to add, if warnings are wanted
+ */
+void QueryParser::warn(const std::string& message)
+{
+    if(warnings != nullptr)
+        warnings->push_back(message);
+}
+
+/**
+ *
+ * warnDangling(const std::string&)
+ *
+ * Warns about an operator that no word or group followed before the next
+ * operator or the end of its group, which has nothing to apply to.
+ *
+ * @param op    - the operator, or an empty string if an operand followed it
+ */
+void QueryParser::warnDangling(const std::string& op)
+{
+    if(!op.empty())
+        warn("The operator " + op + " has no words after it and has been ignored.");
+}
+
+/**
+ *
+ * toString(const QueryNode*)
+ *
+ * Writes a tree as a prefix expression, such as "(AND book (OR boston
+ * seattl))", with the terms of a word joined by '+'. Parentheses that
+ * were written don't change the meaning of a tree, so they are left out.
+ *
+ * @param node  - the root of the tree, or nullptr
+ * @return      - the tree in prefix form, or an empty string for nullptr
+ */
+std::string QueryParser::toString(const QueryNode* node)
+{
+    if(node == nullptr)
+        return "";
+
+    std::string str;
+    if(node->type == QueryNode::TERM)
+    {
+        for(int i{}; i < (int) node->terms.size(); i++)
+            str += (i == 0 ? "" : "+") + node->terms[i];
+        return str;
+    }
+
+    str = (node->type == QueryNode::AND) ? "(AND" : (node->type == QueryNode::OR) ? "(OR" : "(NOT";
+    for(const QueryNode* child : node->children)
+        str += " " + toString(child);
+    return str + ")";
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/**
+ * The QueryNode struct is a node of the syntax tree of a query. A TERM is
+ * a word of the query, stemmed into one or more terms that must all match,
+ * such as the terms of a word written without spaces. AND and OR nodes
+ * hold their operands, and a NOT node holds the operand documents are
+ * taken from, followed by every operand whose documents are taken away.
+ *
+ * The planner of the QueryProcessor drops the operands that aren't in the
+ * index and estimates the number of documents each node can match.
+ *
+ * By: Oisin Coveney
+ */
+struct QueryNode
+{
+    enum Type { TERM, AND, OR, NOT };
+
+    Type type;
+
+    //Stemmed terms of a TERM, and operands of the other nodes, in the order written
+    std::vector<std::string> terms;
+    std::vector<QueryNode*> children;
+
+    //Whether the node was written within parentheses
+    bool grouped;
+
+    //Filled in by the planner: the most documents the node can match, and
+    // its place among its parent's operands as written
+    int estimate;
+    int position;
+
+    //Constructor and destructor, which deletes the operands
+    QueryNode(Type type) : type{type}, terms{}, children{}, grouped{false},
+                           estimate{0}, position{0} {}
+    ~QueryNode();
+
+    QueryNode(const QueryNode&) = delete;
+    QueryNode& operator=(const QueryNode&) = delete;
+};
+
+/**
+ * The QueryParser class parses a boolean query into a tree of QueryNodes.
+ *
+ * A query is a list of words and the operators AND, OR, and NOT, which
+ * can be written before their operands, as in "AND book boston NOT
+ * seattle", or between them, as in "book AND boston NOT seattle". Each
+ * operator applies to every operand after it until the next operator, and
+ * words before the first operator are put together with OR. Operators are
+ * applied from left to right, so "a OR b AND c" is (a OR b) AND c, and
+ * parentheses group operands, so "(a OR b) AND NOT c" takes the documents
+ * of c from those of a or b. An operator inside parentheses ends at the
+ * closing parenthesis.
+ *
+ * Words are stemmed the same way as the documents, and common or short
+ * words are left out. A NOT before the first operand has nothing to take
+ * documents from, so its operands are left out too. Parentheses that
+ * aren't closed are closed at the end of the query, and closing
+ * parentheses that weren't opened are ignored, as are parentheses nested
+ * more than MAX_DEPTH deep and operators with no operand after them.
+ * Every part of a query that is left out or changed is reported with a
+ * warning, as is a query that mixes AND and OR without parentheses, since
+ * it may not mean what was intended.
+ *
+ * By: Oisin Coveney
+ */
+class QueryParser
+{
+    public:
+
+        //Parentheses nested deeper than this are ignored, so a query can't exhaust the stack
+        static const int MAX_DEPTH = 64;
+
+    private:
+
+        //Tokens of the query, and the next one to read
+        std::vector<std::string> tokens;
+        size_t next;
+
+        //Warnings about the parts of the query that were left out, if they are wanted
+        std::vector<std::string>* warnings;
+
+        //Opening parentheses past MAX_DEPTH that haven't been closed
+        int ignored;
+
+        //Problems with the whole query, which are warned about once
+        bool unclosed;
+        bool tooDeep;
+        bool mixed;
+
+        //Constructor
+        QueryParser(const std::string& query, std::vector<std::string>* warnings);
+
+        //Parse operands and operators until a closing parenthesis or the end
+        QueryNode* parseSequence(int depth);
+
+        //Parse a word, or a group within parentheses
+        QueryNode* parseOperand(const std::string& token, int depth);
+
+        //Put an operand together with the operands before it
+        static QueryNode* apply(QueryNode* current, QueryNode::Type operation, QueryNode* operand);
+
+        //Add a warning, and warn about an operator with no operand after it
+        void warn(const std::string& message);
+        void warnDangling(const std::string& op);
+
+    public:
+
+        //Parse a query, returning nullptr if it has no operands
+        static QueryNode* parse(const std::string& query, std::vector<std::string>* warnings = nullptr);
+
+        //Write a tree in a canonical prefix form, the same for every query with the same meaning
+        static std::string toString(const QueryNode* node);
+};
@@ -1,81 +1,425 @@
 #include "queryprocessor.h"
 
+#include <algorithm>
+#include <limits>
+
+ResultCache QueryProcessor::results{};
 
 /**
  *
  * process(std::string, IndexInterface)
  *
- * Takes a simple prefix boolean query containing the operands AND, OR, or NOT
- * to create a Word object that contains a search from the index provided
- * through the parameter.
- *
- * If no operand is provided, the default operation used with be the OR
- * operation.
+ * Takes a boolean query containing the operators AND, OR, or NOT, and
+ * parentheses, to create a Word object that contains a search from the
+ * index provided through the parameter.
  *
- * @param query - a simple prefix boolean query
+ * @param query - a boolean query
  * @param index - the IndexInterface pointer reference containing
  *                  the index to search
  * @return      - a Word object containing the data found from the search
  */
 Word QueryProcessor::process(std::__cxx11::string& query, IndexInterface*& index)
 {
+    std::vector<std::string> warnings;
+    QueryNode* root = QueryParser::parse(query, &warnings);
+    warn(warnings);
+
+    Word word{process(root, findIn(index), Parser::documents.getTombstones())};
+    delete root;
+    return word;
+}
+
+/**
+ *
+ * process(const std::string&, const IndexSnapshot&)
+ *
+ * Searches a snapshot of an index for a query, as process() does for an
+ * index. Only the snapshot is read, so queries can be processed on any
+ * number of threads while the index is written to. The result should be
+ * ranked with IndexSnapshot::getTopDocs(), against the snapshot's counts.
+ *
+ * @param query     - a boolean query
+ * @param snapshot  - the snapshot of the index to search
+ * @return          - a Word object containing the data found from the search
+ */
+Word QueryProcessor::process(const std::string& query, const IndexSnapshot& snapshot)
+{
+    std::vector<std::string> warnings;
+    QueryNode* root = QueryParser::parse(query, &warnings);
+    warn(warnings);
+
+    std::vector<std::shared_ptr<const Word>> found;
+    Word word{process(root, findIn(snapshot, found), snapshot.getDocuments().getTombstones())};
+    delete root;
+    return word;
+}
+
+/**
+ *
+ * search(const std::string&, IndexInterface*&, int)
+ *
+ * Searches the index for a query and ranks the k highest ranked documents.
+ * The result is cached under the normalized query and the index's
+ * generation, so the same query, or one that only differs in spacing,
+ * operators that make no difference, or word endings, is answered from the
+ * cache until the index changes.
+ *
+ * @param query - a boolean query
+ * @param index - the index to search
+ * @param k     - the number of documents to rank
+ * @return      - the ranked result of the query
+ */
+QueryResult QueryProcessor::search(const std::string& query, IndexInterface*& index, int k)
+{
+    std::vector<std::string> warnings;
+    QueryNode* root = QueryParser::parse(query, &warnings);
+    std::string normalized = QueryParser::toString(root);
+    warn(warnings);
+
+    QueryResult result;
+    if(results.find(normalized, k, index->getGeneration(), result))
+    {
+        delete root;
+        return result;
+    }
+
+    Word word{process(root, findIn(index), Parser::documents.getTombstones())};
+    delete root;
+
+    result = QueryResult{word.getWord(), word.getNumDocs(), word.getTopDocs(k)};
+    results.insert(normalized, k, index->getGeneration(), result);
+    return result;
+}
+
+/**
+ *
+ * search(const std::string&, const IndexSnapshot&, int)
+ *
+ * Searches a snapshot for a query and ranks the k highest ranked documents
+ * against the snapshot's counts, using the cache as search() does for an
+ * index. Snapshots published from the same generation of an index have
+ * the same documents and counts, as the index gets a new generation
+ * whenever either changes, so they share their cached results. Safe from
+ * any thread.
+ *
+ * @param query     - a boolean query
+ * @param snapshot  - the snapshot of the index to search
+ * @param k         - the number of documents to rank
+ * @return          - the ranked result of the query
+ */
+QueryResult QueryProcessor::search(const std::string& query, const IndexSnapshot& snapshot, int k)
+{
+    std::vector<std::string> warnings;
+    QueryNode* root = QueryParser::parse(query, &warnings);
+    std::string normalized = QueryParser::toString(root);
+    warn(warnings);
+
+    QueryResult result;
+    if(results.find(normalized, k, snapshot.getGeneration(), result))
+    {
+        delete root;
+        return result;
+    }
+
+    std::vector<std::shared_ptr<const Word>> found;
+    Word word{process(root, findIn(snapshot, found), snapshot.getDocuments().getTombstones())};
+    delete root;
+
+    result = QueryResult{word.getWord(), word.getNumDocs(), snapshot.getTopDocs(word, k)};
+    results.insert(normalized, k, snapshot.getGeneration(), result);
+    return result;
+}
+
+/**
+ *
+ * normalize(const std::string&)
+ *
+ * Rewrites a query into the form its result depends on: its syntax tree,
+ * written by QueryParser::toString(). Every word is stemmed, words that
+ * would be skipped are dropped, and operators that make no difference are
+ * gone, so "book OR boston" and "OR books boston" are the same query.
+ *
+ * @param query - a boolean query
+ * @return      - the normalized query
+ */
+std::string QueryProcessor::normalize(const std::string& query)
+{
+    QueryNode* root = QueryParser::parse(query);
+    std::string normalized = QueryParser::toString(root);
+    delete root;
+    return normalized;
+}
+
+/**
+ *
+ * findIn(IndexInterface*&)
+ *
+ * @param index - the index to search
+ * @return      - a function that finds a word within the index, returning
+ *                nullptr instead of throwing if the word isn't found
+ */
+QueryProcessor::Finder QueryProcessor::findIn(IndexInterface*& index)
+{
+    //Catches the out_of_bounds error if the word isn't found
+    return [&index](const std::string& term) -> const Word*
+    {
+        try
+        {
+            return &index->get(term);
+        }
+        catch (std::out_of_range&)
+        {
+            return nullptr;
+        }
+    };
+}
+
+/**
+ *
+ * findIn(const IndexSnapshot&, vector<shared_ptr<const Word>>&)
+ *
+ * @param snapshot  - the snapshot to search
+ * @param found     - holds every word found, so the words stay valid until
+ *                    the query is done with them
+ * @return          - a function that finds a word within the snapshot
+ */
+QueryProcessor::Finder QueryProcessor::findIn(const IndexSnapshot& snapshot,
+                                              std::vector<std::shared_ptr<const Word>>& found)
+{
+    return [&snapshot, &found](const std::string& term) -> const Word*
+    {
+        std::shared_ptr<const Word> word{snapshot.find(term)};
+        if(word == nullptr)
+            return nullptr;
+
+        found.push_back(word);
+        return word.get();
+    };
+}
 
-    //The object to return
+/**
+ *
+ * warn(const std::vector<std::string>&)
+ *
+ * Tells the user about each part of a query that was left out, such as a
+ * word that is too short or is a common word, or that may not mean what
+ * was intended.
+ *
+ * @param warnings  - the warnings given by the QueryParser
+ */
+void QueryProcessor::warn(const std::vector<std::string>& warnings)
+{
+    for(const std::string& warning : warnings)
+        std::cerr << warning << "\n";
+}
+
+/**
+ *
+ * process(QueryNode*, const Finder&, const PostingList&)
+ *
+ * Plans and runs a parsed query, creating a Word object that contains a
+ * search of the words given by the find function. The Word is named after
+ * the operands of the query in the order they were written, whatever
+ * order they were run in.
+ *
+ * The Word contains every document that matched the query. The documents
+ * are ranked once, after every operation has been applied, when they are
+ * retrieved with Word::getTopDocs(), by adding up the tf-idf of each word
+ * of the query. Documents that have been removed but whose postings
+ * haven't been compacted yet are left out of every word, so they count
+ * towards neither the results nor the idf of a word.
+ *
+ * @param root          - the root of the query's syntax tree, which is planned
+ * @param find          - finds a word, returning nullptr if it doesn't exist
+ * @param tombstones    - the removed documents to leave out
+ * @return              - a Word object containing the data found from the search
+ */
+Word QueryProcessor::process(QueryNode* root, const Finder& find, const PostingList& tombstones)
+{
+    if(root == nullptr || plan(root, find) < 0)
+        return Word{};
+
+    //The result is only copied if it is a word of the index
     Word word{};
+    const Word* result = execute(root, find, tombstones, true, word);
+    if(result != &word)
+        word = *result;
 
-    //A stringstream to containing the query
-    std::stringstream queryStream(query);
+    word.setWord(describe(root));
+    return word;
+}
 
-    //Default operation
-    std::string operation{"OR"};
-    std::string token;
-    while(queryStream >> token)
+/**
+ *
+ * plan(QueryNode*, const Finder&)
+ *
+ * Plans a node of a query before it is run. Operands that aren't in the
+ * index are dropped, as they are skipped by the query, and the number of
+ * documents each node can match is estimated from the length of the
+ * posting lists of its words. The operands of an AND are then sorted by
+ * their estimate, so the rarest are intersected first and every later
+ * intersection only has the few documents left to check.
+ *
+ * A word is missing if any of its terms is; an AND or OR is missing if
+ * all of its operands are, and a NOT if the operand the others are taken
+ * from is.
+ *
+ * @param node  - the node to plan
+ * @param find  - finds a word, returning nullptr if it doesn't exist
+ * @return      - the estimate of the node, or -1 if the node is missing
+ */
+int QueryProcessor::plan(QueryNode* node, const Finder& find)
+{
+    if(node->type == QueryNode::TERM)
     {
-        //Search for the word in the index if they aren't operands
-        if(token != "AND" && token != "OR" && token != "NOT")
+        node->estimate = std::numeric_limits<int>::max();
+        for(const std::string& term : node->terms)
         {
-            if(Parser::invalidLength(token))
-            {
-                std::cout << "The word \"" << token << "\" is too short and"
-                     << " has been deemed irrelevant to the search. The "
-                     << "word will be omitted from the search.\n";
-            }
-            else if(Parser::isStopWord(token))
-            {
-                std::cout << "The word \"" << token << "\" is a common word that"
-                     << " has been deemed irrelevant to the search. The "
-                     << "word will be omitted from the search.\n";
-            }
-            else
-            {
-                //Stems the word and makes it lowercase
-                Porter2Stemmer::stem(token);
-                for(auto it = token.begin(); it != token.end(); ++it)
-                    *it = tolower(*it);
-
-                //Catches the out_of_bounds error if the word isn't found
-                try
-                {
-                    Word& reference = index->get(token);
-
-                    //The operations performed on the word
-                    if(operation == "AND")
-                        word.empty() ? word = reference : word.intersect(reference);
-                    else if(operation == "OR")
-                        word.empty() ? word = reference : word.combine(reference);
-                    else if(operation == "NOT" && !word.empty())
-                        word.difference(reference);
-
-                }
-                catch (std::out_of_range) {}
-
-            }
+            const Word* found = find(term);
+            if(found == nullptr)
+                return -1;
+            node->estimate = std::min(node->estimate, found->getNumDocs());
         }
+        return node->estimate;
+    }
+
+    //Drop the operands that are missing, remembering where each was written
+    std::vector<QueryNode*> present;
+    for(int i{}; i < (int) node->children.size(); i++)
+    {
+        QueryNode* child = node->children[i];
+        child->position = i;
+        if(plan(child, find) >= 0)
+            present.push_back(child);
+        else if(node->type == QueryNode::NOT && i == 0)
+            return -1;
         else
+            delete child;
+    }
+    node->children.swap(present);
+    if(node->children.empty())
+        return -1;
+
+    if(node->type == QueryNode::AND)
+    {
+        std::stable_sort(node->children.begin(), node->children.end(), [](QueryNode* lhs, QueryNode* rhs)
         {
-            //Set the new operation to the token
-            operation = token;
-        }
+            return lhs->estimate < rhs->estimate;
+        });
+        node->estimate = node->children.front()->estimate;
     }
-    return word;
+    else if(node->type == QueryNode::OR)
+    {
+        long long total{};
+        for(QueryNode* child : node->children)
+            total += child->estimate;
+        node->estimate = (int) std::min<long long>(total, std::numeric_limits<int>::max());
+    }
+    else
+    {
+        node->estimate = node->children.front()->estimate;
+    }
+    return node->estimate;
+}
+
+/**
+ *
+ * execute(const QueryNode*, const Finder&, const PostingList&, bool, Word&)
+ *
+ * Runs a planned node of a query. A word of its own is returned straight
+ * from the index when there are no tombstones, without being copied. The
+ * operands of an AND are intersected in the planned order, and those of a
+ * NOT taken away, stopping once no documents are left. The words of an
+ * empty result still rank the documents of an OR it is part of, so an OR
+ * lets none of its operands stop early. Each word is looked up again as
+ * it is used, as a word found earlier may have been evicted from a cache
+ * since.
+ *
+ * @param node          - the planned node to run
+ * @param find          - finds a word, returning nullptr if it doesn't exist
+ * @param tombstones    - the removed documents to leave out
+ * @param stopEarly     - whether the node can stop once it has no documents
+ * @param storage       - holds the result if it isn't a word of the index
+ * @return              - the result of the node, as a word of the index or storage
+ */
+const Word* QueryProcessor::execute(const QueryNode* node, const Finder& find,
+                                    const PostingList& tombstones, bool stopEarly, Word& storage)
+{
+    if(node->type == QueryNode::TERM)
+    {
+        const Word* found = find(node->terms[0]);
+        if(node->terms.size() == 1 && tombstones.empty())
+            return found;
+
+        //Words written without spaces, such as Chinese, split
+        // into several terms that must all match
+        storage = *found;
+        for(int i{1}; i < (int) node->terms.size(); i++)
+            storage.intersect(*find(node->terms[i]));
+
+        //Leave out the tombstones of removed documents
+        if(!tombstones.empty())
+            storage.removeDocs(tombstones);
+        return &storage;
+    }
+
+    //The words of every operand of an OR rank its documents
+    stopEarly = stopEarly && node->type != QueryNode::OR;
+
+    Word operand{};
+    storage = *execute(node->children[0], find, tombstones, stopEarly, operand);
+    for(int i{1}; i < (int) node->children.size(); i++)
+    {
+        if(stopEarly && storage.getNumDocs() == 0)
+            break;
+
+        //The words taken away by a NOT rank nothing, so they can always stop early
+        bool taken = (node->type == QueryNode::NOT);
+        const Word* next = execute(node->children[i], find, tombstones, stopEarly || taken, operand);
+        if(node->type == QueryNode::AND)
+            storage.intersect(*next);
+        else if(node->type == QueryNode::OR)
+            storage.combine(*next);
+        else
+            storage.difference(*next);
+    }
+    return &storage;
+}
+
+/**
+ *
+ * describe(const QueryNode*)
+ *
+ * Names the result of a planned node after its words, in the order they
+ * were written. Words are put together with " and " and " or ", and the
+ * words taken away by a NOT follow ", not ". Groups that were written
+ * within parentheses, and still have more than one operand, are put in
+ * parentheses.
+ *
+ * @param node  - the planned node to describe
+ * @return      - the name of the node's result
+ */
+std::string QueryProcessor::describe(const QueryNode* node)
+{
+    if(node->type == QueryNode::TERM)
+    {
+        std::string str{node->terms[0]};
+        for(int i{1}; i < (int) node->terms.size(); i++)
+            str += " and " + node->terms[i];
+        return str;
+    }
+
+    std::vector<const QueryNode*> written(node->children.begin(), node->children.end());
+    std::sort(written.begin(), written.end(), [](const QueryNode* lhs, const QueryNode* rhs)
+    {
+        return lhs->position < rhs->position;
+    });
+
+    std::string separator = (node->type == QueryNode::AND) ? " and "
+                          : (node->type == QueryNode::OR) ? " or " : ", not ";
+    std::string str{describe(written[0])};
+    for(int i{1}; i < (int) written.size(); i++)
+        str += separator + describe(written[i]);
+
+    return (node->grouped && written.size() > 1) ? "(" + str + ")" : str;
 }
@@ -3,19 +3,70 @@
 
 
 #include <sstream>
+#include <functional>
 #include <Parser/parser.h>
+#include <Index/indexsnapshot.h>
+#include <QueryProcessor/queryparser.h>
+#include <QueryProcessor/resultcache.h>
 
 /**
  * The QueryProcessor is a static class that takes processes a string
  * query, usually inputted by the user, and searches the IndexInterface
- * to find the appropriate word.
+ * to find the appropriate word. Queries on an IndexSnapshot only read the
+ * snapshot, so any number of threads can search it at once.
+ *
+ * A query is parsed into a tree by the QueryParser, then planned before it
+ * is run: words that aren't in the index are dropped, and the operands of
+ * every AND are intersected rarest first, using the length of their
+ * posting lists, so the documents left to check shrink as fast as they can.
+ *
+ * search() also ranks the results, and keeps them in a ResultCache, so a
+ * query that is repeated before the index changes is answered from the
+ * cache.
  *
  * By: Oisin Coveney
  */
 class QueryProcessor
 {
+    private:
+        //Finds a word, returning nullptr if it doesn't exist
+        typedef std::function<const Word*(const std::string&)> Finder;
+
+        static Finder findIn(IndexInterface*& index);
+        static Finder findIn(const IndexSnapshot& snapshot,
+                             std::vector<std::shared_ptr<const Word>>& found);
+
+        //Warn about the parts of a query that were left out
+        static void warn(const std::vector<std::string>& warnings);
+
+        //Plan and run a parsed query, finding each word with the given function
+        static Word process(QueryNode* root, const Finder& find, const PostingList& tombstones);
+
+        //Drop the missing operands of a node, estimate its size, and order its conjunctions
+        static int plan(QueryNode* node, const Finder& find);
+
+        //Run a planned node
+        static const Word* execute(const QueryNode* node, const Finder& find,
+                                   const PostingList& tombstones, bool stopEarly, Word& storage);
+
+        //Name the result of a planned node after its words, as written
+        static std::string describe(const QueryNode* node);
+
     public:
         static Word process(std::__cxx11::string& query, IndexInterface*& index);
+
+        //Search a snapshot of an index, which is safe from any thread
+        static Word process(const std::string& query, const IndexSnapshot& snapshot);
+
+        //Search and rank the k highest ranked documents, using the cached result if there is one
+        static QueryResult search(const std::string& query, IndexInterface*& index, int k);
+        static QueryResult search(const std::string& query, const IndexSnapshot& snapshot, int k);
+
+        //Parse a query into the canonical form its result depends on
+        static std::string normalize(const std::string& query);
+
+        //Results of recent queries
+        static ResultCache results;
 };
 
 #endif // QUERYPROCESSOR_H
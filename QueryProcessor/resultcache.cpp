@@ -0,0 +1,137 @@
+#include <QueryProcessor/resultcache.h>
+
+const size_t ResultCache::DEFAULT_CAPACITY;
+
+/**
+ *
+ * getKey(const std::string&, int)
+ *
+ * @param query - a normalized query
+ * @param k     - the number of documents asked for
+ * @return      - the key of the query's result, which no query can contain
+ */
+std::string ResultCache::getKey(const std::string& query, int k)
+{
+    return query + '\n' + std::to_string(k);
+}
+
+/**
+ *
+ * find(const std::string&, int, uint64_t, QueryResult&)
+ *
+ * Finds the result of a query, and moves it to the front of the list, as
+ * the most recently used. A result from another generation of the index
+ * is out of date, and is removed.
+ *
+ * @param query         - the normalized query
+ * @param k             - the number of documents asked for
+ * @param generation    - the current generation of the index
+ * @param result        - set to a copy of the result, if it is found
+ * @return              - true if the result was found, false if not
+ */
+bool ResultCache::find(const std::string& query, int k, uint64_t generation, QueryResult& result)
+{
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = entries.find(getKey(query, k));
+    if(it == entries.end())
+    {
+        numMisses++;
+        return false;
+    }
+
+    if(it->second->generation != generation)
+    {
+        recent.erase(it->second);
+        entries.erase(it);
+        numMisses++;
+        return false;
+    }
+
+    recent.splice(recent.begin(), recent, it->second);
+    result = it->second->result;
+    numHits++;
+    return true;
+}
+
+/**
+ *
+ * insert(const std::string&, int, uint64_t, const QueryResult&)
+ *
+ * Adds the result of a query to the front of the list, replacing the one
+ * that is cached for the same query, and evicts the least recently used
+ * results once the cache holds more than its capacity.
+ *
+ * @param query         - the normalized query
+ * @param k             - the number of documents asked for
+ * @param generation    - the generation of the index the result was found in
+ * @param result        - the result of the query
+ */
+void ResultCache::insert(const std::string& query, int k, uint64_t generation, const QueryResult& result)
+{
+    if(capacity == 0)
+        return;
+
+    std::string key = getKey(query, k);
+    std::lock_guard<std::mutex> guard(lock);
+
+    auto it = entries.find(key);
+    if(it != entries.end())
+    {
+        recent.erase(it->second);
+        entries.erase(it);
+    }
+
+    recent.push_front(Entry{key, generation, result});
+    entries[key] = recent.begin();
+
+    while(recent.size() > capacity)
+    {
+        entries.erase(recent.back().key);
+        recent.pop_back();
+    }
+}
+
+/**
+ * clear()
+ *
+ * Removes every result and resets the counters
+ */
+void ResultCache::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    entries.clear();
+    recent.clear();
+    numHits = 0;
+    numMisses = 0;
+}
+
+/**
+ * size()
+ * @return  - the number of cached results
+ */
+size_t ResultCache::size()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return recent.size();
+}
+
+/**
+ * getNumHits()
+ * @return  - the number of queries found in the cache
+ */
+uint64_t ResultCache::getNumHits()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return numHits;
+}
+
+/**
+ * getNumMisses()
+ * @return  - the number of queries that weren't found in the cache
+ */
+uint64_t ResultCache::getNumMisses()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return numMisses;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+#include <Word/docdetails.h>
+
+/**
+ * The ranked results of a query: the stemmed words that were searched for,
+ * the number of documents that matched, and the highest ranked of them.
+ */
+struct QueryResult
+{
+    std::string terms;
+    int matches;
+    std::vector<DocDetails> docs;
+};
+
+/**
+ * The ResultCache class holds the ranked results of recent queries, so a
+ * query that is repeated is answered without looking up, merging, or
+ * ranking a single word. Results are keyed by the normalized query, in
+ * which every word has been stemmed, and by the number of documents
+ * asked for.
+ *
+ * Every result is stored with the generation of the index it was found in.
+ * An index gets a new generation whenever documents are added or removed,
+ * or it is loaded, cleared, or compacted, so a result from an older
+ * generation is never returned, and is dropped when it is next looked up.
+ * Once the cache holds its capacity, the least recently used results are
+ * evicted.
+ *
+ * The cache locks itself, so it can be shared by the threads that search
+ * snapshots of an index.
+ *
+ * By: Oisin Coveney
+ */
+class ResultCache
+{
+    public:
+
+        //Default number of results held
+        static const size_t DEFAULT_CAPACITY = 1024;
+
+    private:
+
+        //A result, with its key and the generation of the index it was found in
+        struct Entry
+        {
+            std::string key;
+            uint64_t generation;
+            QueryResult result;
+        };
+
+        //Results in order of use, most recent first, and the position of every key
+        std::list<Entry> recent;
+        std::unordered_map<std::string, std::list<Entry>::iterator> entries;
+
+        size_t capacity;
+        std::mutex lock;
+
+        //Counters
+        uint64_t numHits;
+        uint64_t numMisses;
+
+        //Key of a query and the number of documents asked for
+        static std::string getKey(const std::string& query, int k);
+
+    public:
+
+        //Constructor
+        ResultCache(size_t capacity = DEFAULT_CAPACITY)
+            : recent{}, entries{}, capacity{capacity}, numHits{0}, numMisses{0} {}
+
+        //Find the result of a normalized query in a generation of the index
+        bool find(const std::string& query, int k, uint64_t generation, QueryResult& result);
+
+        //Store the result of a normalized query, evicting the oldest if needed
+        void insert(const std::string& query, int k, uint64_t generation, const QueryResult& result);
+
+        //Remove every result
+        void clear();
+
+        //General functions
+        size_t size();
+        uint64_t getNumHits();
+        uint64_t getNumMisses();
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+/**
+ * The RequestQueue class is a bounded, thread-safe FIFO queue that hands
+ * the requests read by the server's event loop to its worker threads. The
+ * event loop never blocks on the queue: push() fails once the queue holds
+ * its capacity, and the event loop stops reading from its clients until
+ * the workers have made room. Workers block in pop() until there is a
+ * request, or until the queue is closed.
+ *
+ * By: Oisin Coveney
+ */
+template<typename T>
+class RequestQueue
+{
+    private:
+
+        std::deque<T> items;
+        size_t capacity;
+        bool closed;
+
+        std::mutex lock;
+        std::condition_variable available;
+
+    public:
+
+        //Constructor
+        RequestQueue(size_t capacity) : items{}, capacity{capacity}, closed{false} {}
+
+        //Add an item if there is room, returning false if the queue is full or closed
+        bool push(T&& item);
+
+        //Wait for an item, returning false once the queue is closed and empty
+        bool pop(T& item);
+
+        //Wake every waiting thread, and accept no more items
+        void close();
+
+        //Reopen the queue after it has been closed, discarding what was left
+        void reset();
+
+        bool full();
+};
+
+/**
+ *
+ * push(T&&)
+ *
+ * Adds an item to the back of the queue and wakes one waiting thread.
+ *
+ * @param item  - the item to add
+ * @return      - true if the item was added, false if the queue is full or closed
+ */
+template<typename T>
+bool RequestQueue<T>::push(T&& item)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if(closed || items.size() >= capacity)
+            return false;
+        items.push_back(std::move(item));
+    }
+    available.notify_one();
+    return true;
+}
+
+/**
+ *
+ * pop(T&)
+ *
+ * Takes the item at the front of the queue, waiting until there is one.
+ * Items still queued when the queue is closed are handed out first.
+ *
+ * @param item  - set to the item taken
+ * @return      - true if an item was taken, false if the queue is closed and empty
+ */
+template<typename T>
+bool RequestQueue<T>::pop(T& item)
+{
+    std::unique_lock<std::mutex> guard(lock);
+    available.wait(guard, [this] { return closed || !items.empty(); });
+    if(items.empty())
+        return false;
+
+    item = std::move(items.front());
+    items.pop_front();
+    return true;
+}
+
+/**
+ * close()
+ *
+ * Closes the queue, so waiting threads return once it is empty
+ */
+template<typename T>
+void RequestQueue<T>::close()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closed = true;
+    }
+    available.notify_all();
+}
+
+/**
+ * reset()
+ *
+ * Empties and reopens the queue
+ */
+template<typename T>
+void RequestQueue<T>::reset()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    items.clear();
+    closed = false;
+}
+
+/**
+ * full()
+ * @return  - true if the queue holds its capacity, false if not
+ */
+template<typename T>
+bool RequestQueue<T>::full()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return items.size() >= capacity;
+}
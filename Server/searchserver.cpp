@@ -0,0 +1,577 @@
+#include <Server/searchserver.h>
+
+#include <chrono>
+#include <sstream>
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <poll.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+const int SearchServer::QUEUE_CAPACITY;
+const int SearchServer::MAX_CONNECTIONS;
+const size_t SearchServer::MAX_QUERY_LENGTH;
+
+SearchServer* SearchServer::signalled = nullptr;
+
+/**
+ *
+ * SearchServer(IndexInterface*, const std::string&, int, int)
+ *
+ * Creates a server for an index. The index must have been published with
+ * IndexInterface::publish() before the server is run.
+ *
+ * @param index         - the index to search
+ * @param format        - the format of the answers, "tsv" or "json"
+ * @param limit         - the number of documents each answer holds at most
+ * @param numWorkers    - the number of threads that search the index
+ */
+SearchServer::SearchServer(IndexInterface* index, const std::string& format, int limit, int numWorkers)
+    : index{index}, format{format}, limit{limit}, numWorkers{numWorkers < 1 ? 1 : numWorkers},
+      listener{-1}, socketFile{}, wakeup{-1, -1}, connections{}, nextConnection{0},
+      requests{QUEUE_CAPACITY}, responses{}, stopped{false}, numQueries{0}, numAccepted{0}
+{
+    //The pipe lives as long as the server, so stop() can always write to it
+    if(pipe(wakeup) == 0)
+    {
+        fcntl(wakeup[0], F_SETFL, O_NONBLOCK);
+        fcntl(wakeup[1], F_SETFL, O_NONBLOCK);
+    }
+}
+
+/**
+ * Destructor
+ */
+SearchServer::~SearchServer()
+{
+    for(auto& entry : connections)
+        ::close(entry.second.socket);
+    closeSockets();
+
+    for(int fd : wakeup)
+    {
+        if(fd >= 0)
+            ::close(fd);
+    }
+}
+
+/**
+ *
+ * listenUnix(const std::string&)
+ *
+ * Listens on a Unix domain socket. A socket file left behind by a server
+ * that is no longer running is replaced, but any other file is not.
+ *
+ * @param path  - the path of the socket file
+ * @return      - true if the server is listening, false if not, with errno set
+ */
+bool SearchServer::listenUnix(const std::string& path)
+{
+    sockaddr_un address{};
+    if(path.empty() || path.size() >= sizeof(address.sun_path))
+    {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+    struct stat info;
+    if(lstat(path.c_str(), &info) == 0 && S_ISSOCK(info.st_mode))
+        unlink(path.c_str());
+
+    listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(listener < 0)
+        return false;
+
+    if(bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+        int reason = errno;
+        closeSockets();
+        errno = reason;
+        return false;
+    }
+
+    socketFile = path;
+    return true;
+}
+
+/**
+ *
+ * listenTcp(int)
+ *
+ * Listens on a TCP port of the loopback interface, so only clients on the
+ * same machine can connect.
+ *
+ * @param port  - the port to listen on
+ * @return      - true if the server is listening, false if not, with errno set
+ */
+bool SearchServer::listenTcp(int port)
+{
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if(listener < 0)
+        return false;
+
+    int reuse{1};
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if(bind(listener, (sockaddr*) &address, sizeof(address)) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+        int reason = errno;
+        closeSockets();
+        errno = reason;
+        return false;
+    }
+    return true;
+}
+
+/**
+ *
+ * run()
+ *
+ * Starts the worker threads and runs the event loop on the calling thread
+ * until the server is stopped. Each pass hands the waiting queries to the
+ * workers, waits with poll() for a connection, a client, or a worker to be
+ * ready, and then accepts, reads, and writes without blocking. When the
+ * server stops, the queries already queued are answered by the workers,
+ * every connection is closed, and the socket file is removed.
+ */
+void SearchServer::run()
+{
+    if(listener < 0 || wakeup[0] < 0)
+        return;
+    fcntl(listener, F_SETFL, O_NONBLOCK);
+
+    signalled = this;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+
+    requests.reset();
+    for(int i{}; i < numWorkers; i++)
+        workers.push_back(std::thread(&SearchServer::work, this));
+
+    std::vector<pollfd> fds;
+    std::vector<uint64_t> ids;
+    while(!stopped)
+    {
+        dispatch();
+
+        //The wake-up pipe and the listener come before the connections
+        fds.clear();
+        ids.clear();
+        fds.push_back(pollfd{wakeup[0], POLLIN, 0});
+        short accepting = (int) connections.size() < MAX_CONNECTIONS ? POLLIN : 0;
+        fds.push_back(pollfd{listener, accepting, 0});
+
+        bool queueFull = requests.full();
+        for(auto& entry : connections)
+        {
+            Connection& c = entry.second;
+            short events{};
+            if(!c.busy && !c.finished && !queueFull && c.input.find('\n') == std::string::npos)
+                events |= POLLIN;
+            if(!c.output.empty())
+                events |= POLLOUT;
+
+            //A connection with nothing to wait for is left out, so a hang-up isn't reported on every pass
+            fds.push_back(pollfd{events != 0 ? c.socket : -1, events, 0});
+            ids.push_back(entry.first);
+        }
+
+        if(poll(fds.data(), fds.size(), -1) < 0 && errno != EINTR)
+            break;
+
+        if(fds[0].revents != 0)
+            collectResponses();
+        if(fds[1].revents != 0)
+            acceptConnections();
+
+        for(size_t i{}; i < ids.size(); i++)
+        {
+            auto it = connections.find(ids[i]);
+            if(it == connections.end() || fds[i + 2].revents == 0)
+                continue;
+
+            if(fds[i + 2].revents & POLLOUT)
+                writeConnection(it->second);
+            if(fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))
+                readConnection(it->second);
+        }
+
+        //Close the connections that have nothing left to read, answer, or write
+        for(uint64_t id : ids)
+        {
+            auto it = connections.find(id);
+            if(it == connections.end())
+                continue;
+            Connection& c = it->second;
+            if(c.finished && !c.busy && c.output.empty() && c.input.find('\n') == std::string::npos)
+                closeConnection(id);
+        }
+    }
+
+    requests.close();
+    for(std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+
+    while(!connections.empty())
+        closeConnection(connections.begin()->first);
+    responses.clear();
+
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    signalled = nullptr;
+    closeSockets();
+}
+
+/**
+ *
+ * stop()
+ *
+ * Stops the event loop, from any thread or from a signal handler. Only
+ * the atomic flag and write() are used, which are safe in a signal handler.
+ */
+void SearchServer::stop()
+{
+    stopped = true;
+    char byte{'s'};
+    ssize_t written = write(wakeup[1], &byte, 1);
+    (void) written;
+}
+
+/**
+ * handleSignal(int)
+ *
+ * Stops the server that is running when SIGINT or SIGTERM is received
+ *
+ * @param signal    - the signal received
+ */
+void SearchServer::handleSignal(int signal)
+{
+    (void) signal;
+    if(signalled != nullptr)
+        signalled->stop();
+}
+
+/**
+ *
+ * acceptConnections()
+ *
+ * Accepts every connection that is waiting, up to MAX_CONNECTIONS. The
+ * rest wait in the listen backlog until a connection has been closed.
+ */
+void SearchServer::acceptConnections()
+{
+    while((int) connections.size() < MAX_CONNECTIONS)
+    {
+        int client = accept(listener, nullptr, nullptr);
+        if(client < 0)
+            return;
+
+        fcntl(client, F_SETFL, O_NONBLOCK);
+        int noDelay{1};
+        setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        connections[nextConnection++] = Connection{client, std::string{}, std::string{}, false, false};
+        numAccepted++;
+    }
+}
+
+/**
+ *
+ * readConnection(Connection&)
+ *
+ * Reads whatever a client has sent. Once the client has shut down its side
+ * of the connection, the connection is finished, and the queries already
+ * read are still answered, including a last query without a newline. A
+ * connection whose query grows past MAX_QUERY_LENGTH is answered with an
+ * error and finished.
+ *
+ * @param connection    - the connection to read from
+ */
+void SearchServer::readConnection(Connection& connection)
+{
+    char buffer[16384];
+    ssize_t length = recv(connection.socket, buffer, sizeof(buffer), 0);
+    if(length < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return;
+
+    if(length <= 0)
+    {
+        connection.finished = true;
+        if(!connection.input.empty() && connection.input.back() != '\n')
+            connection.input += '\n';
+        return;
+    }
+
+    connection.input.append(buffer, length);
+    if(connection.input.size() > MAX_QUERY_LENGTH && connection.input.find('\n') == std::string::npos)
+    {
+        connection.input.clear();
+        connection.output += error("The query is longer than " + std::to_string(MAX_QUERY_LENGTH) + " bytes.");
+        connection.finished = true;
+    }
+}
+
+/**
+ *
+ * writeConnection(Connection&)
+ *
+ * Writes as much of the waiting answers as the client's socket will take.
+ * A client that can no longer be written to is finished, and what is left
+ * to write to it is dropped.
+ *
+ * @param connection    - the connection to write to
+ */
+void SearchServer::writeConnection(Connection& connection)
+{
+    ssize_t length = send(connection.socket, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+    if(length < 0)
+    {
+        if(errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            connection.output.clear();
+            connection.input.clear();
+            connection.finished = true;
+        }
+        return;
+    }
+    connection.output.erase(0, length);
+}
+
+/**
+ *
+ * dispatch()
+ *
+ * Hands the next query of every connection that isn't waiting for an
+ * answer to the workers, until the queue is full. Empty lines are skipped.
+ * A query that doesn't fit in the queue is left in the connection's input
+ * and handed over on a later pass.
+ */
+void SearchServer::dispatch()
+{
+    for(auto& entry : connections)
+    {
+        Connection& c = entry.second;
+        while(!c.busy)
+        {
+            size_t end = c.input.find('\n');
+            if(end == std::string::npos)
+                break;
+
+            std::string query = c.input.substr(0, end);
+            if(!query.empty() && query.back() == '\r')
+                query.pop_back();
+            if(query.find_first_not_of(" \t") == std::string::npos)
+            {
+                c.input.erase(0, end + 1);
+                continue;
+            }
+
+            if(!requests.push(Request{entry.first, std::move(query)}))
+                return;
+            c.input.erase(0, end + 1);
+            c.busy = true;
+        }
+    }
+}
+
+/**
+ *
+ * collectResponses()
+ *
+ * Empties the wake-up pipe and moves the answers of the workers to the
+ * output of their connections. Answers to connections that have since been
+ * closed are dropped.
+ */
+void SearchServer::collectResponses()
+{
+    char buffer[256];
+    while(read(wakeup[0], buffer, sizeof(buffer)) > 0) {}
+
+    std::vector<Response> finished;
+    {
+        std::lock_guard<std::mutex> guard(responseLock);
+        finished.swap(responses);
+    }
+
+    for(Response& response : finished)
+    {
+        auto it = connections.find(response.connection);
+        if(it == connections.end())
+            continue;
+        it->second.output += response.text;
+        it->second.busy = false;
+    }
+}
+
+/**
+ * closeConnection(uint64_t)
+ *
+ * Closes a connection and forgets it
+ *
+ * @param id    - the number of the connection
+ */
+void SearchServer::closeConnection(uint64_t id)
+{
+    auto it = connections.find(id);
+    if(it == connections.end())
+        return;
+    ::close(it->second.socket);
+    connections.erase(it);
+}
+
+/**
+ *
+ * work()
+ *
+ * Runs on each worker thread. Takes queries from the queue until it is
+ * closed, answers them, and wakes the event loop to write the answers.
+ */
+void SearchServer::work()
+{
+    Request request;
+    while(requests.pop(request))
+    {
+        std::string text = answer(request.query);
+        numQueries++;
+
+        {
+            std::lock_guard<std::mutex> guard(responseLock);
+            responses.push_back(Response{request.connection, std::move(text)});
+        }
+
+        char byte{'r'};
+        ssize_t written = write(wakeup[1], &byte, 1);
+        (void) written;
+    }
+}
+
+/**
+ *
+ * answer(const std::string&)
+ *
+ * Searches the last snapshot published by the index for a query, and
+ * formats the highest ranked documents as the answer.
+ *
+ * @param query - a boolean query
+ * @return      - the answer to write to the client
+ */
+std::string SearchServer::answer(const std::string& query)
+{
+    std::shared_ptr<const IndexSnapshot> snapshot{index->getSnapshot()};
+    if(snapshot == nullptr)
+        return error("No index has been published.");
+
+    std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+    QueryResult result{QueryProcessor::search(query, *snapshot, limit)};
+    std::vector<DocDetails>& docs = result.docs;
+    std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> milliseconds = t2 - t1;
+
+    const DocumentTable& documents = snapshot->getDocuments();
+    std::ostringstream text;
+    if(format == "json")
+    {
+        text << "{\"query\":\"" << escape(query) << "\",";
+        text << "\"terms\":\"" << escape(result.terms) << "\",";
+        text << "\"milliseconds\":" << milliseconds.count() << ",";
+        text << "\"matches\":" << result.matches << ",";
+        text << "\"results\":[";
+        for(int i{}; i < (int) docs.size(); i++)
+        {
+            if(i != 0)
+                text << ",";
+            text << "{\"document\":\"" << escape(documents.getPath(docs[i].id)) << "\",";
+            text << "\"frequency\":" << docs[i].frequency << ",";
+            text << "\"ranking\":" << docs[i].ranking << "}";
+        }
+        text << "]}\n";
+    }
+    else
+    {
+        for(DocDetails& d : docs)
+            text << documents.getPath(d.id) << "\t" << d.frequency << "\t" << d.ranking << "\n";
+        text << "\n";
+    }
+    return text.str();
+}
+
+/**
+ * error(const std::string&)
+ *
+ * @param message   - the error message
+ * @return          - the error as an answer in the server's format
+ */
+std::string SearchServer::error(const std::string& message)
+{
+    if(format == "json")
+        return "{\"error\":\"" + escape(message) + "\"}\n";
+    return "error\t" + message + "\n\n";
+}
+
+/**
+ * closeSockets()
+ *
+ * Closes the listening socket and removes the socket file
+ */
+void SearchServer::closeSockets()
+{
+    if(listener >= 0)
+        ::close(listener);
+    listener = -1;
+
+    if(!socketFile.empty())
+        unlink(socketFile.c_str());
+    socketFile.clear();
+}
+
+/**
+ *
+ * escape(const std::string&)
+ *
+ * Escapes the quotes, backslashes, and control characters of a string so
+ * it can be placed inside a JSON string.
+ *
+ * @param str   - the string to escape
+ * @return      - the escaped string
+ */
+std::string SearchServer::escape(const std::string& str)
+{
+    std::string escaped;
+    for(char c : str)
+    {
+        if(c == '"' || c == '\\')
+        {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if(c == '\n')
+            escaped += "\\n";
+        else if(c == '\t')
+            escaped += "\\t";
+        else if((unsigned char) c < 0x20)
+        {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            escaped += buf;
+        }
+        else
+            escaped += c;
+    }
+    return escaped;
+}
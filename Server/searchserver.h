@@ -0,0 +1,149 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+
+#include <Index/indexinterface.h>
+#include <Index/indexsnapshot.h>
+#include <QueryProcessor/queryprocessor.h>
+#include <Server/requestqueue.h>
+
+/**
+ * The SearchServer class answers queries on an index that is loaded once,
+ * for any number of clients connected over a Unix domain socket or a TCP
+ * port on localhost.
+ *
+ * The protocol is line based. Every line a client sends is a boolean query,
+ * and the server answers the queries of a connection in the order they
+ * were sent. A TSV answer has one document per line, as
+ *  <document>\t<frequency>\t<ranking>
+ * followed by an empty line; a JSON answer is a single line holding the
+ * same object as the search command of IndexCLI. An error is answered
+ * with the line error\t<message> and an empty line, or a JSON object
+ * with an "error" field.
+ *
+ * A single event loop accepts the connections, reads the queries, and
+ * writes the answers, never blocking on a client. Each query is handed to
+ * a pool of worker threads through a bounded RequestQueue, and searched on
+ * the last IndexSnapshot published by the index, so the workers never lock
+ * each other or the index. Backpressure comes from not reading: the event
+ * loop reads the next query of a connection only once the last one has
+ * been answered, stops reading from every connection while the queue is
+ * full, and stops accepting connections at MAX_CONNECTIONS, so a client
+ * sending faster than it can be answered is slowed down by its socket.
+ *
+ * By: Oisin Coveney
+ */
+class SearchServer
+{
+    public:
+
+        //Number of queries waiting for a worker before the clients are no longer read
+        static const int QUEUE_CAPACITY = 256;
+
+        //Number of open connections before no more are accepted
+        static const int MAX_CONNECTIONS = 1024;
+
+        //Length of the longest query, after which the connection is closed
+        static const size_t MAX_QUERY_LENGTH = 64 * 1024;
+
+    private:
+
+        //A query read from a connection, and the answer to it
+        struct Request
+        {
+            uint64_t connection;
+            std::string query;
+        };
+        struct Response
+        {
+            uint64_t connection;
+            std::string text;
+        };
+
+        //A client, with the bytes read from it and still to be written to it
+        struct Connection
+        {
+            int socket;
+            std::string input;
+            std::string output;
+            bool busy;
+            bool finished;
+        };
+
+        //The index whose snapshots are searched
+        IndexInterface* index;
+
+        //Options
+        std::string format;
+        int limit;
+        int numWorkers;
+
+        //Listening socket, the Unix socket file if there is one, and the pipe that wakes the event loop
+        int listener;
+        std::string socketFile;
+        int wakeup[2];
+
+        //Open connections, by the number they were accepted in
+        std::map<uint64_t, Connection> connections;
+        uint64_t nextConnection;
+
+        //Queries waiting for a worker, and answers waiting for the event loop
+        RequestQueue<Request> requests;
+        std::vector<Response> responses;
+        std::mutex responseLock;
+
+        std::vector<std::thread> workers;
+        std::atomic<bool> stopped;
+
+        //Counters
+        std::atomic<uint64_t> numQueries;
+        uint64_t numAccepted;
+
+        //Server stopped by SIGINT and SIGTERM
+        static SearchServer* signalled;
+        static void handleSignal(int signal);
+
+        //Event loop
+        void acceptConnections();
+        void readConnection(Connection& connection);
+        void writeConnection(Connection& connection);
+        void dispatch();
+        void collectResponses();
+        void closeConnection(uint64_t id);
+
+        //Worker threads
+        void work();
+        std::string answer(const std::string& query);
+        std::string error(const std::string& message);
+
+        //Closes the listening socket and removes the socket file
+        void closeSockets();
+
+    public:
+
+        //Constructor and destructor
+        SearchServer(IndexInterface* index, const std::string& format, int limit, int numWorkers);
+        ~SearchServer();
+
+        //Listen on a Unix domain socket, or on a TCP port of localhost
+        bool listenUnix(const std::string& path);
+        bool listenTcp(int port);
+
+        //Serve until stop() is called or SIGINT or SIGTERM is received
+        void run();
+        void stop();
+
+        //Escapes a string so it can be placed inside a JSON string
+        static std::string escape(const std::string& str);
+
+        //Getters
+        uint64_t getNumQueries() const { return numQueries; }
+        uint64_t getNumAccepted() const { return numAccepted; }
+        int getNumWorkers() const { return numWorkers; }
+};
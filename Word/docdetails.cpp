@@ -1,27 +1,6 @@
 #include "docdetails.h"
 
 
-/**
- * Constructor with a single string
- *
- * Uses the information within the string to construct the three variables
- * of the DocDetails object. The string should contain three elements
- * delimited by '\t' characters.
- *
- * @param docInfo   - a string containing the document information
- */
-DocDetails::DocDetails(std::__cxx11::string docInfo)
-    : name{}, frequency{}, ranking{}
-{
-    int delim0 = docInfo.find('\t');
-    int delim1 = docInfo.find('\t', delim0 + 1);
-    int delim2 = docInfo.rfind('\t');
-
-    name = docInfo.substr(delim0 + 1, delim1-1);
-    frequency = std::stoi(docInfo.substr(delim1 + 1, delim2));
-    ranking = std::stod(docInfo.substr(delim2 + 1));
-}
-
 /**
  * Destructor
  */
@@ -49,9 +28,9 @@ void DocDetails::calculateRanking(int totalWordsInDoc, double idf)
 
 /** Operator functions */
 
-bool operator==(const DocDetails& lhs, const std::__cxx11::basic_string<char> rhs)
+bool operator==(const DocDetails& lhs, uint32_t rhs)
 {
-    return lhs.name == rhs;
+    return lhs.id == rhs;
 }
 
 bool DocDetails::operator==(const DocDetails& rhs)
@@ -79,27 +58,27 @@ bool DocDetails::operator>(const DocDetails& rhs)
     return ranking > rhs.ranking;
 }
 
-bool DocDetails::operator==(const std::__cxx11::string& rhs)
+bool DocDetails::operator==(uint32_t rhs)
 {
-    return name == rhs;
+    return id == rhs;
 }
 
-bool DocDetails::operator<=(const std::__cxx11::string& rhs)
+bool DocDetails::operator<=(uint32_t rhs)
 {
-    return name <= rhs;
+    return id <= rhs;
 }
 
-bool DocDetails::operator!=(const std::__cxx11::string& rhs)
+bool DocDetails::operator!=(uint32_t rhs)
 {
-    return name != rhs;
+    return id != rhs;
 }
 
-bool DocDetails::operator<(const std::__cxx11::string& rhs)
+bool DocDetails::operator<(uint32_t rhs)
 {
-    return name < rhs;
+    return id < rhs;
 }
 
-bool DocDetails::operator>(const std::__cxx11::string& rhs)
+bool DocDetails::operator>(uint32_t rhs)
 {
-    return name > rhs;
+    return id > rhs;
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <cmath>
+#include <cstdint>
 
 /**
  * The DocDetails struct contains data that describes a document and
@@ -9,20 +10,22 @@
  * its relevant through the term frequency, inverse document frequency
  * fraction.
  *
+ * The document is identified by its ID within the Parser's DocumentTable,
+ * which holds the path of the document.
+ *
  * By: Oisin
  */
 struct DocDetails
 {
         //Member variables
-        std::string name;
+        uint32_t id;
         int frequency;
         double ranking;
 
         //Constructors
-        DocDetails() : name{}, frequency{0}, ranking{0.0} {}
-        DocDetails(std::string docInfo);
-        DocDetails(std::string docName, int freq, double rank)
-            : name{docName}, frequency{freq}, ranking{rank} {}
+        DocDetails() : id{0}, frequency{0}, ranking{0.0} {}
+        DocDetails(uint32_t docId, int freq, double rank)
+            : id{docId}, frequency{freq}, ranking{rank} {}
         ~DocDetails();
 
         //Get the rankings
@@ -35,13 +38,13 @@ struct DocDetails
         bool operator<(const DocDetails& rhs);
         bool operator>(const DocDetails& rhs);
 
-        bool operator==(const std::string& rhs);
-        bool operator<=(const std::string& rhs);
-        bool operator!=(const std::string& rhs);
-        bool operator<(const std::string& rhs);
-        bool operator>(const std::string& rhs);
+        bool operator==(uint32_t rhs);
+        bool operator<=(uint32_t rhs);
+        bool operator!=(uint32_t rhs);
+        bool operator<(uint32_t rhs);
+        bool operator>(uint32_t rhs);
 
-        friend bool operator==(const DocDetails& lhs, const std::__cxx11::basic_string<char> rhs);
+        friend bool operator==(const DocDetails& lhs, uint32_t rhs);
 };
 
 
@@ -0,0 +1,668 @@
+#include <Word/postinglist.h>
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * The lookup tables of the Stream VByte decoder. For every control byte,
+ * the tables hold the number of data bytes of its four values and the
+ * shuffle that moves those bytes into four 32-bit integers.
+ */
+struct StreamVByteTables
+{
+    uint8_t lengths[256];
+    uint8_t shuffles[256][16];
+
+    StreamVByteTables()
+    {
+        for(int control{}; control < 256; control++)
+        {
+            int offset{};
+            for(int i{}; i < 4; i++)
+            {
+                int length = ((control >> (i * 2)) & 3) + 1;
+                for(int byte{}; byte < 4; byte++)
+                    shuffles[control][i * 4 + byte] = (byte < length) ? offset + byte : 0x80;
+                offset += length;
+            }
+            lengths[control] = offset;
+        }
+    }
+};
+
+/**
+ * getTables()
+ * @return  - the lookup tables of the Stream VByte decoder
+ */
+static const StreamVByteTables& getTables()
+{
+    static const StreamVByteTables tables;
+    return tables;
+}
+
+/**
+ *
+ * encodeValues(const uint32_t*, int, std::vector<uint8_t>&)
+ *
+ * Encodes the values with Stream VByte: the control bytes, holding the
+ * byte length of each value in two bits, followed by the bytes of each
+ * value in little-endian order.
+ *
+ * @param values    - the values to encode
+ * @param n         - the number of values
+ * @param out       - the vector to append the encoded values to
+ */
+static void encodeValues(const uint32_t* values, int n, std::vector<uint8_t>& out)
+{
+    size_t control = out.size();
+    out.resize(out.size() + (n + 3) / 4, 0);
+
+    for(int i{}; i < n; i++)
+    {
+        uint32_t value = values[i];
+        int length = (value < (1u << 8)) ? 1 : (value < (1u << 16)) ? 2
+                   : (value < (1u << 24)) ? 3 : 4;
+
+        out[control + i / 4] |= (length - 1) << ((i % 4) * 2);
+        for(int byte{}; byte < length; byte++)
+            out.push_back((value >> (byte * 8)) & 0xFF);
+    }
+}
+
+/**
+ *
+ * decodeValues(const uint8_t*, const uint8_t*, const uint8_t*, int, uint32_t*)
+ *
+ * Decodes values encoded by encodeValues(). With SSSE3, each group of four
+ * values is decoded with a single shuffle, which reads 16 bytes at a time,
+ * so the shuffle is only used while 16 bytes remain before the limit.
+ *
+ * @param in    - the start of the encoded values
+ * @param end   - the end of the block containing the values
+ * @param limit - the end of the readable memory
+ * @param n     - the number of values
+ * @param out   - the array to decode the values to
+ * @return      - the end of the encoded values, nullptr if they don't
+ *                  fit within the block
+ */
+static const uint8_t* decodeValues(const uint8_t* in, const uint8_t* end,
+                                   const uint8_t* limit, int n, uint32_t* out)
+{
+    const StreamVByteTables& tables = getTables();
+    const uint8_t* control = in;
+    const uint8_t* data = in + (n + 3) / 4;
+    if(data > end)
+        return nullptr;
+
+    //Check that every value lies within the block
+    size_t total{};
+    for(int i{}; i < n / 4; i++)
+        total += tables.lengths[control[i]];
+    for(int i = n - n % 4; i < n; i++)
+        total += ((control[i / 4] >> ((i % 4) * 2)) & 3) + 1;
+    if(total > (size_t) (end - data))
+        return nullptr;
+
+    int i{};
+#if defined(__SSSE3__)
+    for(; i + 4 <= n && limit - data >= 16; i += 4)
+    {
+        uint8_t c = control[i / 4];
+        __m128i bytes = _mm_loadu_si128((const __m128i*) data);
+        __m128i shuffle = _mm_loadu_si128((const __m128i*) tables.shuffles[c]);
+        _mm_storeu_si128((__m128i*) (out + i), _mm_shuffle_epi8(bytes, shuffle));
+        data += tables.lengths[c];
+    }
+#else
+    (void) limit;
+#endif
+
+    for(; i < n; i++)
+    {
+        int length = ((control[i / 4] >> ((i % 4) * 2)) & 3) + 1;
+        uint32_t value{};
+        for(int byte{}; byte < length; byte++)
+            value |= (uint32_t) data[byte] << (byte * 8);
+        out[i] = value;
+        data += length;
+    }
+    return data;
+}
+
+/**
+ *
+ * prefixSum(uint32_t*, int, uint32_t)
+ *
+ * Turns the differences between IDs back into IDs. With SSE2, four IDs
+ * are summed at a time.
+ *
+ * @param values    - the differences, replaced by the IDs
+ * @param n         - the number of values
+ * @param base      - the ID before the first value
+ */
+static void prefixSum(uint32_t* values, int n, uint32_t base)
+{
+    int i{};
+#if defined(__SSE2__)
+    __m128i previous = _mm_set1_epi32((int) base);
+    for(; i + 4 <= n; i += 4)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*) (values + i));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, previous);
+        _mm_storeu_si128((__m128i*) (values + i), v);
+        previous = _mm_shuffle_epi32(v, 0xFF);
+    }
+    if(i > 0)
+        base = values[i - 1];
+#endif
+
+    for(; i < n; i++)
+    {
+        base += values[i];
+        values[i] = base;
+    }
+}
+
+/**
+ *
+ * encodeBlock(const uint32_t*, const uint32_t*, int, uint32_t, std::vector<uint8_t>&)
+ *
+ * Encodes a block of postings: the differences between the IDs, followed
+ * by the frequencies.
+ *
+ * @param ids           - the IDs of the documents, in increasing order
+ * @param frequencies   - the frequencies of the documents
+ * @param n             - the number of postings
+ * @param base          - the ID of the last document of the previous block
+ * @param out           - the vector to append the block to
+ */
+void PostingList::encodeBlock(const uint32_t* ids, const uint32_t* frequencies,
+                              int n, uint32_t base, std::vector<uint8_t>& out)
+{
+    uint32_t deltas[BLOCK_SIZE];
+    for(int i{}; i < n; i++)
+    {
+        deltas[i] = ids[i] - base;
+        base = ids[i];
+    }
+
+    encodeValues(deltas, n, out);
+    encodeValues(frequencies, n, out);
+}
+
+/**
+ *
+ * decodeBlock(const uint8_t*, const uint8_t*, const uint8_t*, int, uint32_t, uint32_t*, uint32_t*)
+ *
+ * Decodes a block of postings encoded by encodeBlock().
+ *
+ * @param data          - the start of the block
+ * @param end           - the end of the block
+ * @param limit         - the end of the readable memory
+ * @param n             - the number of postings
+ * @param base          - the ID of the last document of the previous block
+ * @param ids           - the array to decode the IDs to
+ * @param frequencies   - the array to decode the frequencies to
+ * @return              - true if the block is valid, false if not
+ */
+bool PostingList::decodeBlock(const uint8_t* data, const uint8_t* end, const uint8_t* limit,
+                              int n, uint32_t base, uint32_t* ids, uint32_t* frequencies)
+{
+    data = decodeValues(data, end, limit, n, ids);
+    if(data == nullptr)
+        return false;
+
+    data = decodeValues(data, end, limit, n, frequencies);
+    if(data != end)
+        return false;
+
+    prefixSum(ids, n, base);
+    return true;
+}
+
+/**
+ * getNumBlocks()
+ * @return  - the number of blocks, including the uncompressed block
+ */
+int PostingList::getNumBlocks() const
+{
+    return blocks.size() + (tailIds.empty() ? 0 : 1);
+}
+
+/**
+ * getLastId(int)
+ *
+ * @param block - the number of the block
+ * @return      - the ID of the last document within the block
+ */
+uint32_t PostingList::getLastId(int block) const
+{
+    return (block < (int) blocks.size()) ? blocks[block].lastId : tailIds.back();
+}
+
+/**
+ * flushTail()
+ *
+ * Encodes the uncompressed block and adds it to the encoded blocks.
+ */
+void PostingList::flushTail()
+{
+    uint32_t base = blocks.empty() ? 0 : blocks.back().lastId;
+    encodeBlock(tailIds.data(), tailFrequencies.data(), tailIds.size(), base, bytes);
+    blocks.push_back(BlockHeader{tailIds.back(), (uint32_t) bytes.size()});
+
+    tailIds.clear();
+    tailFrequencies.clear();
+}
+
+/**
+ *
+ * add(uint32_t, uint32_t)
+ *
+ * Adds occurrences of a document to the list. Documents are usually
+ * added in order of ID, in which case the document is either appended or
+ * within the uncompressed block. Otherwise, the list is rebuilt with the
+ * document.
+ *
+ * @param id        - the ID of the document
+ * @param frequency - the number of occurrences to add
+ * @return          - true if the document is new to the list, false if not
+ */
+bool PostingList::add(uint32_t id, uint32_t frequency)
+{
+    if(count == 0 || id > tailIds.back())
+    {
+        append(id, frequency);
+        return true;
+    }
+
+    auto it = std::lower_bound(tailIds.begin(), tailIds.end(), id);
+    if(it != tailIds.end() && *it == id)
+    {
+        tailFrequencies[it - tailIds.begin()] += frequency;
+        return false;
+    }
+
+    //The document is within an encoded block, or is missing from the list
+    PostingList list;
+    bool found{false}, inserted{false};
+    for(Cursor c{*this}; c.valid(); c.next())
+    {
+        if(!inserted && c.id() >= id)
+        {
+            inserted = true;
+            found = (c.id() == id);
+            if(!found)
+                list.append(id, frequency);
+        }
+        list.append(c.id(), c.frequency() + (c.id() == id ? frequency : 0));
+    }
+
+    *this = list;
+    return !found;
+}
+
+/**
+ *
+ * append(uint32_t, uint32_t)
+ *
+ * Adds a document with an ID greater than every document in the list.
+ * The uncompressed block is encoded once it is full.
+ *
+ * @param id        - the ID of the document
+ * @param frequency - the frequency of the word within the document
+ */
+void PostingList::append(uint32_t id, uint32_t frequency)
+{
+    if(tailIds.size() == BLOCK_SIZE)
+        flushTail();
+
+    tailIds.push_back(id);
+    tailFrequencies.push_back(frequency);
+    count++;
+}
+
+/**
+ * size()
+ * @return  - the number of documents within the list
+ */
+int PostingList::size() const
+{
+    return count;
+}
+
+/**
+ * empty()
+ * @return  - true if the list has no documents, false if not
+ */
+bool PostingList::empty() const
+{
+    return count == 0;
+}
+
+/**
+ * getDocs()
+ *
+ * @return  - the decoded documents, in order of ID, without rankings
+ */
+std::vector<DocDetails> PostingList::getDocs() const
+{
+    std::vector<DocDetails> docs;
+    docs.reserve(count);
+    for(Cursor c{*this}; c.valid(); c.next())
+        docs.push_back(DocDetails(c.id(), c.frequency(), 0.0));
+    return docs;
+}
+
+/**
+ *
+ * unite(const PostingList&, const PostingList&)
+ *
+ * Merges two lists in a single pass. The frequencies of documents within
+ * both lists are added together.
+ *
+ * @param lhs   - the first list
+ * @param rhs   - the second list
+ * @return      - the documents within either list
+ */
+PostingList PostingList::unite(const PostingList& lhs, const PostingList& rhs)
+{
+    PostingList list;
+    Cursor l{lhs}, r{rhs};
+    while(l.valid() && r.valid())
+    {
+        if(l.id() < r.id())
+        {
+            list.append(l.id(), l.frequency());
+            l.next();
+        }
+        else if(r.id() < l.id())
+        {
+            list.append(r.id(), r.frequency());
+            r.next();
+        }
+        else
+        {
+            list.append(l.id(), l.frequency() + r.frequency());
+            l.next();
+            r.next();
+        }
+    }
+
+    for(; l.valid(); l.next())
+        list.append(l.id(), l.frequency());
+    for(; r.valid(); r.next())
+        list.append(r.id(), r.frequency());
+    return list;
+}
+
+/**
+ *
+ * intersect(const PostingList&, const PostingList&)
+ *
+ * Intersects two lists by leapfrogging: whichever cursor is behind skips
+ * to the ID of the other. Skips gallop, so this is linear when the lists
+ * are of similar length, and logarithmic in the longer list when one is
+ * much shorter. The minimum frequency of each document is kept.
+ *
+ * @param lhs   - the first list
+ * @param rhs   - the second list
+ * @return      - the documents within both lists
+ */
+PostingList PostingList::intersect(const PostingList& lhs, const PostingList& rhs)
+{
+    PostingList list;
+    Cursor l{lhs}, r{rhs};
+    while(l.valid() && r.valid())
+    {
+        if(l.id() < r.id())
+            l.skipTo(r.id());
+        else if(r.id() < l.id())
+            r.skipTo(l.id());
+        else
+        {
+            list.append(l.id(), std::min(l.frequency(), r.frequency()));
+            l.next();
+            r.next();
+        }
+    }
+    return list;
+}
+
+/**
+ *
+ * subtract(const PostingList&, const PostingList&)
+ *
+ * Removes the documents of the second list from the first. The second
+ * list is skipped through, so only the blocks near the documents of the
+ * first list are decoded.
+ *
+ * @param lhs   - the list to remove documents from
+ * @param rhs   - the documents to remove
+ * @return      - the documents within lhs that aren't within rhs
+ */
+PostingList PostingList::subtract(const PostingList& lhs, const PostingList& rhs)
+{
+    PostingList list;
+    Cursor l{lhs}, r{rhs};
+    for(; l.valid(); l.next())
+    {
+        r.skipTo(l.id());
+        if(!r.valid() || r.id() != l.id())
+            list.append(l.id(), l.frequency());
+    }
+    return list;
+}
+
+/**
+ *
+ * serialize(std::string&)
+ *
+ * Appends the serialized list to the string: a BlockHeader for each
+ * block, followed by the encoded blocks. The uncompressed block is
+ * encoded as the last block.
+ *
+ * @param out   - the string to append the list to
+ */
+void PostingList::serialize(std::string& out) const
+{
+    std::vector<BlockHeader> headers{blocks};
+    std::vector<uint8_t> last;
+    if(!tailIds.empty())
+    {
+        uint32_t base = blocks.empty() ? 0 : blocks.back().lastId;
+        encodeBlock(tailIds.data(), tailFrequencies.data(), tailIds.size(), base, last);
+        headers.push_back(BlockHeader{tailIds.back(), (uint32_t) (bytes.size() + last.size())});
+    }
+
+    out.append((const char*) headers.data(), headers.size() * sizeof(BlockHeader));
+    out.append((const char*) bytes.data(), bytes.size());
+    out.append((const char*) last.data(), last.size());
+}
+
+/**
+ *
+ * deserialize(const char*, size_t, uint32_t, uint32_t)
+ *
+ * Reads a list written by serialize(). Every block is decoded once to
+ * check that it is valid and that its IDs are increasing, and the last
+ * block is kept uncompressed.
+ *
+ * @param data          - the serialized list
+ * @param length        - the length of the serialized list
+ * @param numPostings   - the number of documents within the list
+ * @param numDocuments  - the number of documents in the index, which every
+ *                          ID must be below
+ * @return              - true if the list is valid, false if not
+ */
+bool PostingList::deserialize(const char* data, size_t length, uint32_t numPostings,
+                              uint32_t numDocuments)
+{
+    if(numPostings == 0)
+    {
+        *this = PostingList();
+        return true;
+    }
+
+    int numBlocks = (numPostings + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    size_t headerLength = numBlocks * sizeof(BlockHeader);
+    if(length < headerLength)
+        return false;
+
+    std::vector<BlockHeader> headers(numBlocks);
+    std::memcpy(headers.data(), data, headerLength);
+
+    const uint8_t* payload = (const uint8_t*) data + headerLength;
+    size_t payloadLength = length - headerLength;
+
+    PostingList list;
+    uint32_t ids[BLOCK_SIZE], frequencies[BLOCK_SIZE];
+    uint32_t start{}, base{};
+    for(int block{}; block < numBlocks; block++)
+    {
+        int n = (block == numBlocks - 1) ? numPostings - block * BLOCK_SIZE : BLOCK_SIZE;
+        if(headers[block].end < start || headers[block].end > payloadLength)
+            return false;
+
+        if(!decodeBlock(payload + start, payload + headers[block].end, payload + payloadLength,
+                        n, base, ids, frequencies) || ids[n - 1] != headers[block].lastId
+                || ids[n - 1] >= numDocuments)
+            return false;
+
+        for(int i{}; i < n; i++)
+        {
+            if((i > 0 || block > 0) && ids[i] <= (i > 0 ? ids[i - 1] : base))
+                return false;
+        }
+
+        if(block == numBlocks - 1)
+        {
+            list.tailIds.assign(ids, ids + n);
+            list.tailFrequencies.assign(frequencies, frequencies + n);
+        }
+
+        start = headers[block].end;
+        base = headers[block].lastId;
+    }
+
+    if(numBlocks > 1)
+    {
+        list.blocks.assign(headers.begin(), headers.end() - 1);
+        list.bytes.assign(payload, payload + list.blocks.back().end);
+    }
+    list.count = numPostings;
+
+    *this = list;
+    return true;
+}
+
+/**
+ * Constructor
+ *
+ * Creates a cursor at the first document of the list.
+ *
+ * @param list  - the list to step through
+ */
+PostingList::Cursor::Cursor(const PostingList& list)
+    : list(list), block{0}, position{0}, length{0}
+{
+    load(0);
+}
+
+/**
+ *
+ * load(int)
+ *
+ * Decodes a block and moves to its first document. If the block is past
+ * the end of the list, the cursor is no longer valid.
+ *
+ * @param block - the number of the block
+ */
+void PostingList::Cursor::load(int block)
+{
+    this->block = block;
+    position = 0;
+    length = 0;
+
+    if(block < (int) list.blocks.size())
+    {
+        uint32_t start = (block == 0) ? 0 : list.blocks[block - 1].end;
+        uint32_t base = (block == 0) ? 0 : list.blocks[block - 1].lastId;
+        const uint8_t* data = list.bytes.data();
+
+        decodeBlock(data + start, data + list.blocks[block].end, data + list.bytes.size(),
+                    BLOCK_SIZE, base, ids, frequencies);
+        length = BLOCK_SIZE;
+    }
+    else if(block == (int) list.blocks.size())
+    {
+        length = list.tailIds.size();
+        std::copy(list.tailIds.begin(), list.tailIds.end(), ids);
+        std::copy(list.tailFrequencies.begin(), list.tailFrequencies.end(), frequencies);
+    }
+}
+
+/**
+ * next()
+ *
+ * Moves to the next document, decoding the next block if needed.
+ */
+void PostingList::Cursor::next()
+{
+    if(++position >= length && block < list.getNumBlocks())
+        load(block + 1);
+}
+
+/**
+ *
+ * skipTo(uint32_t)
+ *
+ * Moves to the first document with an ID of at least the target. Blocks
+ * that end before the target are skipped without being decoded, using a
+ * binary search over the last ID of each block. Within a block, the search
+ * steps forward in doubling strides and then binary searches the last
+ * stride, so skipping over k documents costs O(log k) comparisons.
+ *
+ * @param target    - the ID to skip to
+ */
+void PostingList::Cursor::skipTo(uint32_t target)
+{
+    if(!valid() || ids[position] >= target)
+        return;
+
+    //Skip the blocks that end before the target
+    if(ids[length - 1] < target)
+    {
+        int low{block + 1}, high{list.getNumBlocks()};
+        while(low < high)
+        {
+            int mid = low + (high - low) / 2;
+            if(list.getLastId(mid) < target)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+
+        load(low);
+        if(!valid())
+            return;
+    }
+
+    //Gallop within the block
+    int step{1}, low{position}, high{position};
+    while(high < length && ids[high] < target)
+    {
+        low = high + 1;
+        high += step;
+        step *= 2;
+    }
+    position = std::lower_bound(ids + low, ids + std::min(high, length), target) - ids;
+}
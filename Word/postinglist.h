@@ -0,0 +1,118 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include <Word/docdetails.h>
+
+/**
+ * The PostingList class stores the documents of a word in compressed form.
+ * The documents are sorted by ID and grouped into blocks of BLOCK_SIZE
+ * postings. Within a block, the differences between consecutive IDs and the
+ * frequencies are each encoded with Stream VByte: one control byte holds the
+ * byte lengths of four values, followed by the bytes of the values. Blocks
+ * are decoded four values at a time with SSSE3 shuffles where available.
+ *
+ * The last block is kept uncompressed, so the frequency of the document
+ * being parsed can be incremented in place.
+ *
+ * The serialized form, which is stored in the index file, is one
+ * BlockHeader for each block, followed by the encoded blocks.
+ *
+ * By: Oisin Coveney
+ */
+class PostingList
+{
+    public:
+
+        //Number of postings in every block but the last
+        static const int BLOCK_SIZE = 128;
+
+        struct BlockHeader
+        {
+            uint32_t lastId;
+            uint32_t end;
+        };
+
+        /**
+         * A Cursor steps through the postings of a list in order of ID,
+         * decoding one block at a time. skipTo() passes over whole blocks
+         * using the last ID of each block, and gallops within a block.
+         */
+        class Cursor
+        {
+            private:
+
+                const PostingList& list;
+
+                //Decoded postings of the current block
+                int block;
+                int position;
+                int length;
+                uint32_t ids[BLOCK_SIZE];
+                uint32_t frequencies[BLOCK_SIZE];
+
+                void load(int block);
+
+            public:
+
+                Cursor(const PostingList& list);
+
+                bool valid() const { return position < length; }
+                uint32_t id() const { return ids[position]; }
+                uint32_t frequency() const { return frequencies[position]; }
+
+                //Move to the next posting, or the first with an ID >= target
+                void next();
+                void skipTo(uint32_t target);
+        };
+
+    private:
+
+        //Full, encoded blocks
+        std::vector<BlockHeader> blocks;
+        std::vector<uint8_t> bytes;
+
+        //Last block, uncompressed
+        std::vector<uint32_t> tailIds;
+        std::vector<uint32_t> tailFrequencies;
+
+        //Number of postings
+        uint32_t count;
+
+        //Encoding and decoding of blocks
+        void flushTail();
+        int getNumBlocks() const;
+        uint32_t getLastId(int block) const;
+        static void encodeBlock(const uint32_t* ids, const uint32_t* frequencies,
+                                int n, uint32_t base, std::vector<uint8_t>& out);
+        static bool decodeBlock(const uint8_t* data, const uint8_t* end, const uint8_t* limit,
+                                int n, uint32_t base, uint32_t* ids, uint32_t* frequencies);
+
+    public:
+
+        //Constructor
+        PostingList() : blocks{}, bytes{}, tailIds{}, tailFrequencies{}, count{0} {}
+
+        //Add occurrences of a document, returning true if it is new
+        bool add(uint32_t id, uint32_t frequency = 1);
+
+        //Add a document with an ID greater than every other document
+        void append(uint32_t id, uint32_t frequency);
+
+        //Getters
+        int size() const;
+        bool empty() const;
+        std::vector<DocDetails> getDocs() const;
+
+        //Union, intersection, and difference of two lists
+        static PostingList unite(const PostingList& lhs, const PostingList& rhs);
+        static PostingList intersect(const PostingList& lhs, const PostingList& rhs);
+        static PostingList subtract(const PostingList& lhs, const PostingList& rhs);
+
+        //Persistence
+        void serialize(std::string& out) const;
+        bool deserialize(const char* data, size_t length, uint32_t numPostings,
+                         uint32_t numDocuments);
+};
@@ -20,13 +20,14 @@
 std::ostream& operator<<(std::ostream& o, const Word& word)
 {
     o << std::endl;
-    o << word.getWord() << " :: " << word.numDocs << " documents";
+    o << word.getWord() << " :: " << word.getNumDocs() << " documents";
     o << " :: " << word.totalFrequency << " times" << std::endl;
-    for(int i{}; i < (int) word.docs.size(); i++)
+    for(DocDetails& d : word.getDocs())
     {
         o << "\t";
-        o << word.docs[i].name << "\t" << word.docs[i].frequency << "\t";
-        o << std::setprecision(2) << std::fixed << word.docs[i].ranking;
+        o << Parser::documents.getPath(d.id) << "\t";
+        o << d.frequency << "\t";
+        o << std::setprecision(2) << std::fixed << d.ranking;
         o << std::endl;
     }
     return o;
@@ -43,107 +44,296 @@ std::ostream& operator<<(std::ostream& o, const Word& word)
 Word&Word::operator=(const Word& other)
 {
     word = other.word;
-    docs = other.docs;
-    numDocs = other.numDocs;
+    postings = other.postings;
     totalFrequency = other.totalFrequency;
+    rankedTerms = other.rankedTerms;
     return *this;
 }
 
+/**
+ * Destructor
+ */
+Word::~Word()
+{
+    totalFrequency = 0;
+}
+
 /**
  *
- * Constructor with std::string and std::istream&
+ * addDoc(uint32_t, uint32_t)
  *
- * Constructs the word object by iterating through the istream reference
- * and pulling data into the Word object
+ * Adds occurrences of the word within the document with the given ID.
  *
- * @param name  - the string of the word
- * @param is    - the istream reference
+ * @param document  - the ID of the document within the DocumentTable
+ * @param frequency - the number of occurrences to add
  */
-Word::Word(std::string& name, std::istream& is)
-    : word{name}, docs{}, numDocs{}, totalFrequency{}
+void Word::addDoc(uint32_t document, uint32_t frequency)
 {
-    is.ignore(4);
-    is >> numDocs;
-    is.ignore(14);
-    is >> totalFrequency;
-    is.ignore(7);
-
-    //Gets all the documents found within the file
-    std::string docInfo;
-    for(int i{}; i < numDocs && i < NUM_DOCS; i++)
-    {
-        getline(is, docInfo);
-        docs.push_back(DocDetails(docInfo));
-    }
+    postings.add(document, frequency);
+    totalFrequency += frequency;
 }
 
 /**
- * Destructor
+ *
+ * merge(const Word&)
+ *
+ * Adds the documents of the same word from another part of the index,
+ * such as another segment. Documents within both have their frequencies
+ * added together, and so do the total frequencies.
+ *
+ * @param other - the same word, from another part of the index
  */
-Word::~Word()
+void Word::merge(const Word& other)
 {
-    docs.clear();
-    numDocs = 0;
+    postings = PostingList::unite(postings, other.postings);
+    totalFrequency += other.totalFrequency;
 }
 
 /**
  *
- * addDoc(std::string)
+ * removeDocs(const PostingList&)
  *
+ * Removes documents from the word's postings, and takes their occurrences
+ * of the word off the total frequency. The postings are only rebuilt if
+ * the word is in one of the documents, which is checked by intersecting
+ * the lists first.
  *
- *
- * @param document
+ * @param documents - the IDs of the documents to remove
+ * @return          - true if the word was in any of the documents, false if not
  */
-void Word::addDoc(std::string document)
+bool Word::removeDocs(const PostingList& documents)
 {
-    // Finds the document within the list of documents
-    auto it = std::find_if(docs.begin(), docs.end(), [document](DocDetails d)
-    {
-              return d.name == document;
-});
-    //If the document exists, add to frequency
-    if(it != docs.end())
+    //Most words aren't in any of the documents, which is found by skipping
+    PostingList common = PostingList::intersect(postings, documents);
+    if(common.empty())
+        return false;
+
+    int removedFrequency{0};
+    PostingList kept;
+    PostingList::Cursor c{postings}, remove{documents};
+    for(; c.valid(); c.next())
     {
-        it->frequency++;
-    }
-    else
-    {
-        //Adds the document to the doc list
-        numDocs++;
-        docs.push_back(DocDetails(document, 1, 0.0));
+        remove.skipTo(c.id());
+        if(remove.valid() && remove.id() == c.id())
+            removedFrequency += c.frequency();
+        else
+            kept.append(c.id(), c.frequency());
     }
 
-    totalFrequency++;
+    postings = kept;
+    totalFrequency -= removedFrequency;
+    return true;
 }
 
 /**
- * calculateRanking()
  *
- * Calculates the tf-idf ranking for all files within the list of documents.
+ * getIdf(int, int)
+ *
+ * @param numFiles  - the number of documents in the index
+ * @param numDocs   - the number of documents the word is in
+ * @return          - the inverse document frequency of the word, normalized so
+ *                      no fractions must be divided by 0
  */
-void Word::calculateRanking()
+double Word::getIdf(int numFiles, int numDocs)
 {
-    // idf ranking, normalized so no fractions must be divided by 0
-    double idf = 1 + log2((double) Parser::getNumFiles() / numDocs);
+    return 1 + log2((double) numFiles / numDocs);
+}
 
-    //Iterates through the list calculating the ranking
+/**
+ *
+ * addRankedTerms(const Word&)
+ *
+ * Remembers the postings of the words two Words are built from, before
+ * this Word's postings are changed by a query. A Word that was not built
+ * by a query is a word of its own.
+ *
+ * @param other - the Word this Word is being put together with
+ */
+void Word::addRankedTerms(const Word& other)
+{
+    if(rankedTerms.empty() && !postings.empty())
+        rankedTerms.push_back(std::make_shared<const PostingList>(postings));
+
+    if(!other.rankedTerms.empty())
+        rankedTerms.insert(rankedTerms.end(), other.rankedTerms.begin(), other.rankedTerms.end());
+    else if(!other.postings.empty())
+        rankedTerms.push_back(std::make_shared<const PostingList>(other.postings));
+}
+
+/**
+ * getDocs()
+ *
+ * Decodes every document of the word and calculates its tf-idf ranking
+ * from the current counts of the Parser.
+ *
+ * @return  - the documents of the word, sorted by ID
+ */
+std::vector<DocDetails> Word::getDocs() const
+{
+    return getDocs(Parser::documents, Parser::getNumFiles());
+}
+
+/**
+ *
+ * getDocs(const DocumentTable&, int)
+ *
+ * Decodes every document of the word and calculates its tf-idf ranking
+ * from the given counts, such as those of an IndexSnapshot.
+ *
+ * @param documents - the table holding the word count of every document
+ * @param numFiles  - the number of documents in the index
+ * @return          - the documents of the word, sorted by ID
+ */
+std::vector<DocDetails> Word::getDocs(const DocumentTable& documents, int numFiles) const
+{
+    double idf = getIdf(numFiles, postings.size());
+    std::vector<PostingList::Cursor> terms{getTermCursors()};
+    std::vector<double> idfs{getTermIdfs(numFiles)};
+    std::vector<DocDetails> docs{postings.getDocs()};
     for(DocDetails& d : docs)
+        rank(d, terms, idfs, idf, documents);
+    return docs;
+}
+
+/**
+ * getTermCursors()
+ *
+ * @return  - a cursor over the postings of each ranked term
+ */
+std::vector<PostingList::Cursor> Word::getTermCursors() const
+{
+    std::vector<PostingList::Cursor> terms;
+    terms.reserve(rankedTerms.size());
+    for(const std::shared_ptr<const PostingList>& t : rankedTerms)
+        terms.emplace_back(*t);
+    return terms;
+}
+
+/**
+ * getTermIdfs(int)
+ *
+ * @param numFiles  - the number of documents in the index
+ * @return          - the inverse document frequency of each ranked term
+ */
+std::vector<double> Word::getTermIdfs(int numFiles) const
+{
+    std::vector<double> idfs;
+    idfs.reserve(rankedTerms.size());
+    for(const std::shared_ptr<const PostingList>& t : rankedTerms)
+        idfs.push_back(getIdf(numFiles, t->size()));
+    return idfs;
+}
+
+/**
+ *
+ * rank(DocDetails&, vector<PostingList::Cursor>&, const vector<double>&,
+ *      double, const DocumentTable&)
+ *
+ * Calculates the tf-idf ranking of a document from the frequency of the
+ * word within it, its number of words, and the number of documents in the
+ * index. A Word built by a query adds up the ranking of each of its words
+ * within the document instead. Documents must be ranked in order of ID, as
+ * the cursors only move forward.
+ *
+ * @param document  - the document to rank
+ * @param terms     - a cursor over the postings of each ranked term
+ * @param idfs      - the inverse document frequency of each ranked term
+ * @param idf       - the inverse document frequency of this Word
+ * @param documents - the table holding the word count of every document
+ */
+void Word::rank(DocDetails& document, std::vector<PostingList::Cursor>& terms,
+                const std::vector<double>& idfs, double idf,
+                const DocumentTable& documents) const
+{
+    int totalWordsInDoc = documents.getWordCount(document.id);
+    if(terms.empty())
     {
-        d.calculateRanking(Parser::totalWordsInDoc[d.name], idf);
+        document.calculateRanking(totalWordsInDoc, idf);
+        return;
     }
 
-    //Sorts the list based on ranking
-    std::sort(docs.rbegin(), docs.rend(), [](DocDetails& lhs, DocDetails& rhs)
+    double ranking{0.0};
+    for(size_t i{}; i < terms.size(); i++)
     {
-        return lhs.ranking < rhs.ranking;
-    });
+        terms[i].skipTo(document.id);
+        if(terms[i].valid() && terms[i].id() == document.id)
+        {
+            DocDetails term(document.id, terms[i].frequency(), 0.0);
+            term.calculateRanking(totalWordsInDoc, idfs[i]);
+            ranking += term.ranking;
+        }
+    }
+    document.ranking = ranking;
+}
+
+/**
+ *
+ * getTopDocs(int)
+ *
+ * Ranks every document of the word against the current counts of the
+ * Parser and returns the highest ranked, from the highest ranking to the
+ * lowest.
+ *
+ * @param k - the number of documents to return
+ * @return  - the k highest ranked documents
+ */
+std::vector<DocDetails> Word::getTopDocs(int k) const
+{
+    return getTopDocs(k, Parser::documents, Parser::getNumFiles());
+}
 
-    //Pops all documents that are small and outside the bounds of what
-    // is needed for the project
-    while(docs.size() > NUM_DOCS)
+/**
+ *
+ * getTopDocs(int, const DocumentTable&, int)
+ *
+ * Ranks every document of the word and returns the highest ranked, from
+ * the highest ranking to the lowest. Rankings are always calculated from
+ * the counts given, so they are never out of date. The documents are
+ * selected with a min-heap that holds at most k documents, so selecting
+ * from n documents takes O(n log k) time. Documents with equal rankings
+ * are ordered by ID.
+ *
+ * @param k         - the number of documents to return
+ * @param documents - the table holding the word count of every document
+ * @param numFiles  - the number of documents in the index
+ * @return          - the k highest ranked documents
+ */
+std::vector<DocDetails> Word::getTopDocs(int k, const DocumentTable& documents, int numFiles) const
+{
+    //Whether a document ranks higher than another
+    auto higher = [](const DocDetails& lhs, const DocDetails& rhs)
     {
-        docs.pop_back();
+        return lhs.ranking > rhs.ranking
+                || (lhs.ranking == rhs.ranking && lhs.id < rhs.id);
+    };
+
+    double idf = getIdf(numFiles, postings.size());
+    std::vector<PostingList::Cursor> terms{getTermCursors()};
+    std::vector<double> idfs{getTermIdfs(numFiles)};
+
+    //The front of the heap is the lowest ranked document kept so far
+    std::vector<DocDetails> heap;
+    heap.reserve(std::min(std::max(k, 0), postings.size()));
+    for(PostingList::Cursor c{postings}; c.valid() && k > 0; c.next())
+    {
+        DocDetails d(c.id(), c.frequency(), 0.0);
+        rank(d, terms, idfs, idf, documents);
+
+        if((int) heap.size() < k)
+        {
+            heap.push_back(d);
+            std::push_heap(heap.begin(), heap.end(), higher);
+        }
+        else if(higher(d, heap.front()))
+        {
+            std::pop_heap(heap.begin(), heap.end(), higher);
+            heap.back() = d;
+            std::push_heap(heap.begin(), heap.end(), higher);
+        }
     }
+
+    std::sort_heap(heap.begin(), heap.end(), higher);
+    return heap;
 }
 
 
@@ -164,7 +354,10 @@ bool Word::empty()
  *
  * Combines two words and their documents, using the premise of the OR operator.
  * The documents within the other word are added to the document list
- * within this Word. If documents match, their frequencies are added together.
+ * within this Word. If documents match, their frequencies are added together,
+ * and their rankings are the sum of their rankings within each word.
+ *
+ * Both lists are sorted by ID, so they are merged in a single pass.
  *
  * The words are concatenated with an ' or ' between the two words.
  *
@@ -173,31 +366,9 @@ bool Word::empty()
  */
 Word& Word::combine(const Word& other)
 {
+    addRankedTerms(other);
     word += (" or " + other.getWord());
-
-
-
-    for(DocDetails od : other.docs)
-    {
-        //Finds the document within this doc list
-        auto it = std::find(docs.begin(), docs.end(), od.name);
-
-        //If found, the frequencies are added together
-        if(it != docs.end())
-        {
-            it->frequency += od.frequency;
-        }
-        //If not, then the document is added to the list
-        else
-        {
-            numDocs++;
-            docs.push_back(od);
-        }
-
-    }
-
-    //Calculate the new tf-idf rankings of the list
-    calculateRanking();
+    postings = PostingList::unite(postings, other.postings);
     return *this;
 }
 
@@ -208,7 +379,10 @@ Word& Word::combine(const Word& other)
  * Puts the two words together based on the premise of intersection,
  * in which only the elements that the two Words have in common with
  * each other will remain. Thus, only documents that both Word objects
- * have will be retained.
+ * have will be retained, with the minimum of their frequencies.
+ *
+ * The lists skip ahead to each other's documents, so a short list
+ * intersected with a long one only decodes the blocks it needs.
  *
  * The words are concatenated with an ' and ' between the two words.
  *
@@ -217,28 +391,9 @@ Word& Word::combine(const Word& other)
  */
 Word& Word::intersect(const Word& other)
 {
+    addRankedTerms(other);
     word += (" and " + other.getWord());
-
-    //Iterate through all of this Word's documents
-    for (auto it = docs.begin(); it != docs.end();)
-    {
-
-        //If no documents match, remove from docs list
-        auto otherIt = std::find(other.docs.begin(), other.docs.end(), it->name);
-        if (otherIt == other.docs.end())               //if no elements match
-        {
-            numDocs--;
-            it = docs.erase(it++);
-        }
-        //Otherwise, get the minimum frequency and make that the new frequency
-        else
-        {
-            it->frequency = std::min(it->frequency, otherIt->frequency);
-            ++it;
-        }
-    }
-
-    calculateRanking();
+    postings = PostingList::intersect(postings, other.postings);
     return *this;
 }
 
@@ -257,25 +412,10 @@ Word& Word::intersect(const Word& other)
  */
 Word& Word::difference(const Word& other)
 {
+    //Only this Word's own words rank the documents that are left
+    addRankedTerms(Word());
     word += (", not " + other.getWord());
-
-    for (auto it = docs.begin(); it != docs.end();)
-    {
-        //If the documents match, remove from this Document list
-        auto otherIt = std::find(other.docs.begin(), other.docs.end(), it->name);
-        if (otherIt != other.docs.end())               //elements match
-        {
-            numDocs--;
-            it = docs.erase(it++);
-        }
-        //Otherwise, simply iterate
-        else
-        {
-            ++it;
-        }
-    }
-
-    calculateRanking();
+    postings = PostingList::subtract(postings, other.postings);
     return *this;
 }
 
@@ -7,20 +7,30 @@
 #include <algorithm>
 #include <sstream>
 #include <fstream>
+#include <memory>
 
 #include <Word/docdetails.h>
+#include <Word/postinglist.h>
+#include <Parser/documenttable.h>
 #include <Parser/parser.h>
 
 
+//Default number of documents returned by a query
 #define NUM_DOCS 15
 
 /**
  * The Word class is an object that encapsulates a word within an index
- * for the PDF search engine. The Word object contains a vector
- * of DocDetails objects, which contain the data of each document
- * where the word exists. The Word class also contains the functions
- * for a union, intersection, and difference of a Word object,
- * which are useful within the QueryProcessor class.
+ * for the PDF search engine. The Word object contains a compressed
+ * PostingList of the documents where the word exists, sorted by document
+ * ID. Rankings are calculated when the documents are retrieved. The Word
+ * class also contains the functions for a union, intersection, and
+ * difference of a Word object, which are useful within the QueryProcessor
+ * class.
+ *
+ * A Word built from several words by a query remembers the postings of
+ * each word it was built from, and ranks a document by adding up the tf-idf
+ * of every one of those words within it. Rankings use the Parser's counts,
+ * or the counts of an IndexSnapshot when they are given.
  */
 class Word
 {
@@ -28,28 +38,58 @@ class Word
 
         //member variables
         std::string word;
-        std::vector<DocDetails> docs;
-        int numDocs;
+        PostingList postings;
         int totalFrequency;
 
+        //Postings of the words of a query whose rankings are added up,
+        // shared between copies of the Word
+        std::vector<std::shared_ptr<const PostingList>> rankedTerms;
+
+        //Remember the words this Word is built from, before it changes
+        void addRankedTerms(const Word& other);
+
+        //Rank a document, moving the cursors over the ranked terms to it
+        void rank(DocDetails& document, std::vector<PostingList::Cursor>& terms,
+                  const std::vector<double>& idfs, double idf,
+                  const DocumentTable& documents) const;
+        std::vector<PostingList::Cursor> getTermCursors() const;
+        std::vector<double> getTermIdfs(int numFiles) const;
+
+        //Inverse document frequency of a word within a number of documents
+        static double getIdf(int numFiles, int numDocs);
+
 
     public:
 
         //Constructors and destructor
-        Word() : word{}, docs{}, numDocs{}, totalFrequency{} {}
+        Word() : word{}, postings{}, totalFrequency{}, rankedTerms{} {}
         Word(const Word& other)
-            : word{other.word}, docs{other.docs},
-              numDocs{other.numDocs}, totalFrequency{other.totalFrequency} {}
+            : word{other.word}, postings{other.postings},
+              totalFrequency{other.totalFrequency}, rankedTerms{other.rankedTerms} {}
         Word& operator=(const Word& other);
         Word(std::string word)
-            : word{word}, docs{}, numDocs{}, totalFrequency{} {}
-        Word(std::string& name, std::istream& is);
+            : word{word}, postings{}, totalFrequency{}, rankedTerms{} {}
+        Word(std::string word, PostingList postings, int totalFrequency)
+            : word{word}, postings{postings}, totalFrequency{totalFrequency}, rankedTerms{} {}
         ~Word();
 
 
-        //Add document to word and calculate the ranking of all documents
-        void addDoc(std::__cxx11::string document);
-        void calculateRanking();
+        //Add document to word
+        void addDoc(uint32_t document, uint32_t frequency = 1);
+
+        //Add the documents of the same word from another part of the index
+        void merge(const Word& other);
+
+        //Remove documents, along with their occurrences of the word
+        bool removeDocs(const PostingList& documents);
+
+        //Get the ranked documents, or the k highest ranked documents
+        std::vector<DocDetails> getDocs() const;
+        std::vector<DocDetails> getTopDocs(int k) const;
+
+        //Rank the documents against the counts of a given table of documents
+        std::vector<DocDetails> getDocs(const DocumentTable& documents, int numFiles) const;
+        std::vector<DocDetails> getTopDocs(int k, const DocumentTable& documents, int numFiles) const;
 
         //Check if word == ""
         bool empty();
@@ -76,7 +116,7 @@ class Word
         bool operator>(std::string& rhs);
 
         //getters and setters
-        std::__cxx11::string getWord() const
+        const std::string& getWord() const
         {
             return word;
         }
@@ -84,6 +124,10 @@ class Word
         {
             word = value;
         }
+        int getNumDocs() const
+        {
+            return postings.size();
+        }
         int getTotalFrequency() const
         {
             return totalFrequency;
@@ -92,12 +136,8 @@ class Word
         {
             totalFrequency = value;
         }
-        std::vector<DocDetails> getDocs() const
-        {
-            return docs;
-        }
-        void setDocs(const std::vector<DocDetails>& value)
+        const PostingList& getPostings() const
         {
-            docs = value;
+            return postings;
         }
 };
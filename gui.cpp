@@ -14,7 +14,7 @@ void GUI::clearAll()
     Parser::numFiles = 0;
     Parser::numPages = 0;
     Parser::numWords = 0;
-    Parser::totalWordsInDoc.clear();
+    Parser::documents.clear();
     directory = "";
 }
 
@@ -27,7 +27,7 @@ void GUI::clearAll()
  * whether the index is valid and should be searched. If not, the user
  * will be prompted to build the index.
  *
- * Otherwise, the user will input a simple prefix boolean search query
+ * Otherwise, the user will input a boolean search query
  * as a search query. The query is then processed and the results are
  * outputted to the console. The user then has the option to open
  * the PDFs by scrolling through the list, and can return to the main menu
@@ -64,8 +64,8 @@ void GUI::searchIndex()
     getstr(input);
     std::string in{input};
 
-    //Gets the word created by the query processor
-    Word word{QueryProcessor::process(in, index)};
+    //Gets the ranked result of the query processor
+    QueryResult result{QueryProcessor::search(in, index, NUM_DOCS)};
     noecho();
     //End user input
 
@@ -75,7 +75,7 @@ void GUI::searchIndex()
 
     //If no results are found, the user receives a prompt saying that
     // no results are found.
-    if(word.empty())
+    if(result.terms.empty())
     {
         mvprintw(row / 2 - 1, (col - 10) / 2, "The search");
         attron(A_BOLD);
@@ -96,8 +96,8 @@ void GUI::searchIndex()
 
     //Header with bolded word
     attron(A_BOLD | A_UNDERLINE);
-    mvprintw((row - 18) / 3, (col - word.getWord().size()) / 2,
-             word.getWord().c_str());
+    mvprintw((row - 18) / 3, (col - result.terms.size()) / 2,
+             result.terms.c_str());
     attroff(A_BOLD | A_UNDERLINE);
 
     //Subheader showing the directory
@@ -114,7 +114,7 @@ void GUI::searchIndex()
 
 
     //Vector for outputting the files to the console
-    std::vector<DocDetails> docs{word.getDocs()};
+    std::vector<DocDetails>& docs = result.docs;
     int maxSize = (int) docs.size();
 
     int c{}, choice{0};
@@ -132,7 +132,7 @@ void GUI::searchIndex()
 
             DocDetails& d = docs[i];
 
-            file = d.name;
+            file = Parser::documents.getPath(d.id);
 
             file = file.substr(directory.size());
 
@@ -182,7 +182,7 @@ void GUI::searchIndex()
         if(c == 10 && choice != 15)
         {
             QDesktopServices::openUrl
-                    (QUrl::fromLocalFile((docs[choice].name.c_str())));
+                    (QUrl::fromLocalFile((Parser::documents.getPath(docs[choice].id).c_str())));
         }
 
         refresh();
@@ -280,8 +280,8 @@ void GUI::buildIndex()
     if(directoryCheck != "")
     {
         //Options for user
-        const char* indexOptions[2] =
-        {"Reload the index", "Load it from file"};
+        const char* indexOptions[3] =
+        {"Reload the index", "Load it from file", "Refresh changed files"};
 
         //Header and menu for file loading choice
         int c{}, choice{};
@@ -299,7 +299,7 @@ void GUI::buildIndex()
         //Menu
         while(c != 10)
         {
-            highlightMenuItem(choice, indexOptions, 2, row / 2 + 3);
+            highlightMenuItem(choice, indexOptions, 3, row / 2 + 3);
 
             c = getch();
 
@@ -311,20 +311,28 @@ void GUI::buildIndex()
 
             if(choice < 0)
                 choice = 0;
-            else if(choice > 1)
-                choice = 1;
+            else if(choice > 2)
+                choice = 2;
 
             refresh();
         }
 
         //If the user chooses to load from file
-        if(choice)
+        if(choice == 1)
         {
             directory = directoryCheck;
             buildFromFile();
             return;
         }
 
+        //If the user chooses to refresh the file
+        if(choice == 2)
+        {
+            directory = directoryCheck;
+            refreshFromFile();
+            return;
+        }
+
     }
 
     //User has denied all options, and will reload index
@@ -358,6 +366,37 @@ void GUI::buildFromFile()
     windowBorder();
 }
 
+/**
+ * refreshFromFile()
+ *
+ * Loads the index from the persistent index file, then parses only the
+ * PDFs in its directory that are new or have changed since the file was
+ * written, and removes the PDFs that have been deleted. The refreshed
+ * index is written back to the file.
+ *
+ */
+void GUI::refreshFromFile()
+{
+    clear();
+    windowBorder();
+
+    mvprintw(2, 5, "Refreshing...");
+
+    index->load();
+
+    ProgressRenderer renderer{Parser::progress, row, col};
+    renderer.start();
+    Parser::refresh(directory, index);
+    renderer.stop();
+    index->printToFile();
+
+    mvprintw(2, 5, "Done Refreshing. Press any key to return to the main menu.");
+    refresh();
+    getch();
+    clear();
+    windowBorder();
+}
+
 /**
  * buildFromScratch()
  *
@@ -411,7 +450,10 @@ void GUI::buildFromScratch()
 
     mvprintw(2, 5, "Parsing...");
 
-    Parser::parse(directory, index, row, col);
+    ProgressRenderer renderer{Parser::progress, row, col};
+    renderer.start();
+    Parser::parse(directory, index);
+    renderer.stop();
     index->printToFile();
 
     mvprintw(2, 5, "Done Parsing. Press any key to return to the main menu.");
@@ -542,7 +584,10 @@ void GUI::addDirectory()
     //Presents the parsing screen for a beautiful representation of parsing
     mvprintw(2, 5, "Parsing new directory...");
 
-    Parser::addExtraDirectory(in, index, row, col);
+    ProgressRenderer renderer{Parser::progress, row, col};
+    renderer.start();
+    Parser::addExtraDirectory(in, index);
+    renderer.stop();
     index->printToFile();
 
     mvprintw(2, 5, "Done Parsing. Press any key to return to the main menu.");
@@ -610,7 +655,10 @@ void GUI::addFile()
     windowBorder();
 
     //Parses the file and provides prompt
+    ProgressRenderer renderer{Parser::progress, row, col};
+    renderer.start();
     Parser::addExtraDoc(in, index);
+    renderer.stop();
 
     attron(A_BOLD);
     mvprintw(row / 2, (col - 40) / 2, "New file added. Press any key "
@@ -833,7 +881,8 @@ void GUI::displayAnalytics()
     //Most frequent words
     mvprintw(15, (col - 20) / 2, "Most frequent words:");
 
-    int maxSize{(int) index->frequentWords.size()};
+    std::vector<Word*> frequentWords{index->getFrequentWords()};
+    int maxSize{(int) frequentWords.size()};
 
     int i{};
     int offset{0};                             //Offset for displaying the words
@@ -843,9 +892,9 @@ void GUI::displayAnalytics()
             offset = 2;
 
         mvprintw(16 + (i % (maxSize / 2)), (2 + offset) * col / 7,
-                 index->frequentWords[i]->getWord().c_str());
+                 frequentWords[i]->getWord().c_str());
         mvprintw(16 + (i % (maxSize / 2)), (2 + offset) * col / 7 + 20,
-                 std::to_string(index->frequentWords[i]->getTotalFrequency()).c_str());
+                 std::to_string(frequentWords[i]->getTotalFrequency()).c_str());
         ++i;
     }
 
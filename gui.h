@@ -19,6 +19,7 @@
 #include <Index/hashindex.h>
 #include <Parser/parser.h>
 #include <QueryProcessor/queryprocessor.h>
+#include <progressrenderer.h>
 
 
 using namespace std;
@@ -67,6 +68,7 @@ class GUI
         /// Build the index
         void buildIndex();
         void buildFromFile();
+        void refreshFromFile();
         void buildFromScratch();
 
         /// Add files
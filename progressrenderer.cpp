@@ -0,0 +1,126 @@
+#include "progressrenderer.h"
+
+/**
+ * Constructor
+ *
+ * @param progress          - the counters published by the Parser
+ * @param row               - the vertical size of the screen
+ * @param col               - the horizontal size of the screen
+ * @param framesPerSecond   - the number of times the screen is redrawn a second
+ */
+ProgressRenderer::ProgressRenderer(ParseProgress& progress, int row, int col,
+                                   int framesPerSecond)
+    : progress{progress}, row{row}, col{col},
+      frameTime{1000 / std::max(1, framesPerSecond)}, thread{}, running{false}
+{
+}
+
+/**
+ * Destructor
+ */
+ProgressRenderer::~ProgressRenderer()
+{
+    stop();
+}
+
+/**
+ * start()
+ *
+ * Starts the drawing thread.
+ */
+void ProgressRenderer::start()
+{
+    if(thread.joinable())
+        return;
+
+    running = true;
+    thread = std::thread(&ProgressRenderer::run, this);
+}
+
+/**
+ * stop()
+ *
+ * Stops the drawing thread and draws a final frame, so the screen shows
+ * the totals of the finished parse.
+ */
+void ProgressRenderer::stop()
+{
+    if(!thread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        running = false;
+    }
+    stopped.notify_all();
+    thread.join();
+
+    draw();
+}
+
+/**
+ * run()
+ *
+ * Redraws the screen once every frame until stop() is called.
+ */
+void ProgressRenderer::run()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while(running)
+    {
+        guard.unlock();
+        draw();
+        guard.lock();
+
+        stopped.wait_for(guard, std::chrono::milliseconds(frameTime),
+                         [this] { return !running; });
+    }
+}
+
+/**
+ *
+ * draw()
+ *
+ * Draws the number of files, pages, and words parsed, the average parse
+ * time, and a stream of the most recently parsed files.
+ */
+void ProgressRenderer::draw()
+{
+    std::string str = ("File " + std::to_string(progress.filesParsed) + "/"
+                       + std::to_string(progress.totalFiles));
+    mvprintw(3, 5, str.c_str());
+
+    str = ("Pages: " + std::to_string(progress.pages));
+    mvprintw(3, 25, str.c_str());
+
+    str = ("Words: " + std::to_string(progress.words));
+    mvprintw(3, 45, str.c_str());
+
+    str = ("Average Parse Time (ms): "
+           + std::to_string(progress.getAverageParseTime()));
+    mvprintw(3, 65, str.c_str());
+
+    //Output for the stream of documents being parsed, newest at the top
+    std::vector<std::string> files = progress.getRecentFiles(3 * row / 4);
+    for(int i{}; i < (int) files.size(); i++)
+    {
+        std::string& file = files[i];
+
+        //If the filename is long, truncate it.
+        if((int) file.size() > col - 25)
+        {
+            file.erase(col - 28, file.size());
+            file = ("..." + file);
+        }
+
+        //Clears the line so that the stream can be repopulated
+        for(int k{}; k < col - 10; k++)
+        {
+            mvaddch(6 + i, 8 + k, ' ');
+        }
+        mvaddch(6 + i, col - 2, '*');
+        mvprintw(6 + i, 8, file.c_str());
+    }
+
+    refresh();
+}
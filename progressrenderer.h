@@ -0,0 +1,57 @@
+#pragma once
+
+#include <ncurses.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <algorithm>
+
+#include <Parser/parseprogress.h>
+
+/**
+ * The ProgressRenderer class draws the progress screen shown while the
+ * index is being built. It runs on its own thread and redraws the screen
+ * from a ParseProgress object at a fixed frame rate, so the cost of
+ * terminal output does not depend on how many pages or words are parsed.
+ *
+ * ncurses must not be used by any other thread between start() and stop().
+ *
+ * By: Oisin Coveney
+ */
+class ProgressRenderer
+{
+    private:
+
+        //Counters to draw
+        ParseProgress& progress;
+
+        //Max height and width of the terminal window
+        int row, col;
+
+        //Time between frames in milliseconds
+        int frameTime;
+
+        //Drawing thread and the signal to stop it
+        std::thread thread;
+        bool running;
+        std::mutex lock;
+        std::condition_variable stopped;
+
+        //Loop run by the drawing thread
+        void run();
+
+        //Draw a single frame
+        void draw();
+
+    public:
+
+        //Constructor and destructor
+        ProgressRenderer(ParseProgress& progress, int row, int col,
+                         int framesPerSecond = 10);
+        ~ProgressRenderer();
+
+        //Start and stop drawing
+        void start();
+        void stop();
+};